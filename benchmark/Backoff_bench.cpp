@@ -0,0 +1,95 @@
+#include <memory>
+
+#include <benchmark/benchmark.h>
+
+#include <Backoff.h>
+#include <MPMCRingBuffer.h>
+#include <MSQueue.h>
+#include <UnboundedStack.h>
+
+namespace
+{
+    constexpr std::size_t BufferSize = 1 << 16;
+
+    template <class Backoff>
+    using MPMCLFRingBuffer = lockfree::MPMCRingBuffer<int, BufferSize, std::allocator<int>, Backoff>;
+    template <class Backoff>
+    using MSQueue = lockfree::MSQueue<int, Backoff>;
+    template <class Backoff>
+    using UnboundedStack = lockfree::UnboundedStack<int, Backoff>;
+}
+
+// Every thread pushes and pops the same container back to back, so every CAS is contended.
+template <template <class> class Container, class Backoff>
+static void BM_ContendedPushPop(benchmark::State& state) {
+    static std::unique_ptr<Container<Backoff>> shared;
+
+    if (state.thread_index() == 0)
+    {
+        shared = std::make_unique<Container<Backoff>>();
+    }
+
+    for (auto _ : state)
+    {
+        shared->Push(1);
+        benchmark::DoNotOptimize(shared->Pop());
+    }
+
+    if (state.thread_index() == 0)
+    {
+        shared.reset();
+    }
+
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+
+// UnboundedStack deletes a node as soon as it is popped, so only one thread may pop:
+// every other thread pushes, and thread 0 pops against them.
+template <class Backoff>
+static void BM_ContendedPushSinglePop(benchmark::State& state) {
+    static std::unique_ptr<UnboundedStack<Backoff>> shared;
+
+    if (state.thread_index() == 0)
+    {
+        shared = std::make_unique<UnboundedStack<Backoff>>();
+    }
+
+    for (auto _ : state)
+    {
+        if (state.thread_index() == 0)
+        {
+            benchmark::DoNotOptimize(shared->Pop());
+        }
+        else
+        {
+            shared->Push(1);
+        }
+    }
+
+    if (state.thread_index() == 0)
+    {
+        shared.reset();
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_ContendedPushPop<MPMCLFRingBuffer, backoff::None>)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(BM_ContendedPushPop<MPMCLFRingBuffer, backoff::Pause>)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(BM_ContendedPushPop<MPMCLFRingBuffer, backoff::Yield>)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(BM_ContendedPushPop<MPMCLFRingBuffer, backoff::Exponential<>>)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(BM_ContendedPushPop<MPMCLFRingBuffer, backoff::Adaptive<>>)->ThreadRange(1, 16)->UseRealTime();
+
+BENCHMARK(BM_ContendedPushPop<MSQueue, backoff::None>)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(BM_ContendedPushPop<MSQueue, backoff::Pause>)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(BM_ContendedPushPop<MSQueue, backoff::Yield>)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(BM_ContendedPushPop<MSQueue, backoff::Exponential<>>)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(BM_ContendedPushPop<MSQueue, backoff::Adaptive<>>)->ThreadRange(1, 16)->UseRealTime();
+
+BENCHMARK(BM_ContendedPushSinglePop<backoff::None>)->ThreadRange(2, 16)->UseRealTime();
+BENCHMARK(BM_ContendedPushSinglePop<backoff::Pause>)->ThreadRange(2, 16)->UseRealTime();
+BENCHMARK(BM_ContendedPushSinglePop<backoff::Yield>)->ThreadRange(2, 16)->UseRealTime();
+BENCHMARK(BM_ContendedPushSinglePop<backoff::Exponential<>>)->ThreadRange(2, 16)->UseRealTime();
+BENCHMARK(BM_ContendedPushSinglePop<backoff::Adaptive<>>)->ThreadRange(2, 16)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,169 @@
+#include <array>
+#include <chrono>
+#include <thread>
+
+#include <benchmark/benchmark.h>
+
+#include <ConflatingQueue.h>
+#include <CpuRelax.h>
+#include <SPSCRingBuffer.h>
+#include <TripleBuffer.h>
+
+namespace
+{
+    constexpr std::size_t KeysAmount = 16;
+    constexpr std::size_t BufferSize = 1 << 16;
+
+    using Snapshot = std::array<long long, KeysAmount>;
+
+    // What the consumer does with one update, e.g. repricing an instrument.
+    void Process(long long value)
+    {
+        for (int i = 0; i < 64; ++i)
+        {
+            cpu::Relax();
+        }
+        benchmark::DoNotOptimize(value);
+    }
+
+    // Every update goes through, stale or not.
+    class RingBufferFeed
+    {
+        struct Update
+        {
+            std::size_t key;
+            long long value;
+        };
+
+    public:
+        void Publish(std::size_t key, long long value)
+        {
+            while (!buffer_.Push(Update{key, value})) {}
+        }
+
+        template <class Fn>
+        void Consume(Fn&& fn)
+        {
+            while (auto update = buffer_.Pop())
+            {
+                fn(update->key, update->value);
+            }
+        }
+
+    private:
+        lockfree::SPSCRingBuffer<Update, BufferSize> buffer_;
+    };
+
+    // The producer publishes whole snapshots; the consumer reprocesses only the keys that changed.
+    class TripleBufferFeed
+    {
+    public:
+        TripleBufferFeed()
+        {
+            current_.fill(-1);
+            seen_.fill(-1);
+            buffer_.Write(current_);
+        }
+
+        void Publish(std::size_t key, long long value)
+        {
+            current_[key] = value;
+            buffer_.Write(current_);
+        }
+
+        template <class Fn>
+        void Consume(Fn&& fn)
+        {
+            if (!buffer_.Update())
+            {
+                return;
+            }
+
+            const auto& snapshot = buffer_.Read();
+            for (std::size_t key = 0; key < KeysAmount; ++key)
+            {
+                if (snapshot[key] != seen_[key])
+                {
+                    seen_[key] = snapshot[key];
+                    fn(key, snapshot[key]);
+                }
+            }
+        }
+
+    private:
+        lockfree::TripleBuffer<Snapshot> buffer_;
+        Snapshot current_;
+        Snapshot seen_;
+    };
+
+    class ConflatingFeed
+    {
+    public:
+        void Publish(std::size_t key, long long value)
+        {
+            queue_.Push(key, value);
+        }
+
+        template <class Fn>
+        void Consume(Fn&& fn)
+        {
+            while (auto update = queue_.Pop())
+            {
+                fn(update->first, update->second);
+            }
+        }
+
+    private:
+        lockfree::ConflatingQueue<long long, KeysAmount> queue_;
+    };
+}
+
+// The producer writes bursts of updates round-robin over the keys and pauses between bursts. Time runs until
+// the consumer has processed the final value of every key; "processed" is how many updates it had to handle
+// on the way.
+template <class Feed>
+static void BM_BurstyFeed(benchmark::State& state) {
+    const auto updates = static_cast<long long>(state.range(0));
+    const auto burst = static_cast<long long>(state.range(1));
+
+    long long processed = 0;
+    for (auto _ : state)
+    {
+        Feed feed;
+
+        std::jthread producer([&feed, updates, burst]()
+        {
+            for (long long i = 0; i < updates; ++i)
+            {
+                feed.Publish(static_cast<std::size_t>(i) % KeysAmount, i);
+                if ((i + 1) % burst == 0)
+                {
+                    std::this_thread::sleep_for(std::chrono::microseconds(20));
+                }
+            }
+        });
+
+        std::size_t finished = 0;
+        while (finished < KeysAmount)
+        {
+            feed.Consume([&](std::size_t, long long value)
+            {
+                Process(value);
+                ++processed;
+                if (value >= updates - static_cast<long long>(KeysAmount))
+                {
+                    ++finished;
+                }
+            });
+        }
+    }
+
+    state.counters["processed"] = benchmark::Counter(static_cast<double>(processed), benchmark::Counter::kAvgIterations);
+    state.SetItemsProcessed(state.iterations() * updates);
+}
+
+BENCHMARK(BM_BurstyFeed<RingBufferFeed>)->ArgsProduct({{100'000}, {100, 1'000, 10'000}})->UseRealTime();
+BENCHMARK(BM_BurstyFeed<TripleBufferFeed>)->ArgsProduct({{100'000}, {100, 1'000, 10'000}})->UseRealTime();
+BENCHMARK(BM_BurstyFeed<ConflatingFeed>)->ArgsProduct({{100'000}, {100, 1'000, 10'000}})->UseRealTime();
+
+BENCHMARK_MAIN();
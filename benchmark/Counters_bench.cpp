@@ -0,0 +1,115 @@
+#include <atomic>
+#include <limits>
+#include <memory>
+
+#include <benchmark/benchmark.h>
+
+#include <StripedCounter.h>
+
+namespace
+{
+    constexpr std::size_t ReadEvery = 1024;
+
+    class AtomicCounter
+    {
+    public:
+        void Increment()
+        {
+            value_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        std::size_t Load() const
+        {
+            return value_.load(std::memory_order_relaxed);
+        }
+
+    private:
+        std::atomic<std::size_t> value_{0};
+    };
+
+    class AtomicMax
+    {
+    public:
+        void Record(long long value)
+        {
+            auto current = value_.load(std::memory_order_relaxed);
+            while (value > current && !value_.compare_exchange_weak(current, value, std::memory_order_relaxed))
+            {
+            }
+        }
+
+        long long Load() const
+        {
+            return value_.load(std::memory_order_relaxed);
+        }
+
+    private:
+        std::atomic<long long> value_{std::numeric_limits<long long>::lowest()};
+    };
+}
+
+// Every thread bumps the same counter and reads it back every ReadEvery increments, like a consumer that
+// checks whether everything has been popped yet.
+template <class Counter>
+static void BM_Increment(benchmark::State& state)
+{
+    static std::unique_ptr<Counter> shared;
+
+    if (state.thread_index() == 0)
+    {
+        shared = std::make_unique<Counter>();
+    }
+
+    std::size_t i = 0;
+    for (auto _ : state)
+    {
+        shared->Increment();
+        if (++i % ReadEvery == 0)
+        {
+            benchmark::DoNotOptimize(shared->Load());
+        }
+    }
+
+    if (state.thread_index() == 0)
+    {
+        shared.reset();
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Latencies that mostly do not beat the running maximum, with an occasional new record per thread.
+template <class Max>
+static void BM_RecordMax(benchmark::State& state)
+{
+    static std::unique_ptr<Max> shared;
+
+    if (state.thread_index() == 0)
+    {
+        shared = std::make_unique<Max>();
+    }
+
+    long long value = 0;
+    for (auto _ : state)
+    {
+        ++value;
+        shared->Record((value & 1023) == 0 ? value : value & 1023);
+    }
+
+    // The loop ends at a barrier across threads, so the others are done recording.
+    if (state.thread_index() == 0)
+    {
+        benchmark::DoNotOptimize(shared->Load());
+        shared.reset();
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_Increment<AtomicCounter>)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(BM_Increment<lockfree::StripedCounter<>>)->ThreadRange(1, 16)->UseRealTime();
+
+BENCHMARK(BM_RecordMax<AtomicMax>)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(BM_RecordMax<lockfree::StripedMax<long long>>)->ThreadRange(1, 16)->UseRealTime();
+
+BENCHMARK_MAIN();
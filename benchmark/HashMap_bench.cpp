@@ -0,0 +1,93 @@
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <unordered_map>
+
+#include <benchmark/benchmark.h>
+
+#include <ConcurrentHashMap.h>
+
+namespace
+{
+    constexpr uint64_t KeysAmount = 1ULL << 16;
+
+    class MutexHashMap
+    {
+    public:
+        std::optional<uint32_t> Find(uint64_t key)
+        {
+            std::lock_guard guard(mutex_);
+            if (auto it = map_.find(key); it != map_.end())
+            {
+                return it->second;
+            }
+            return std::nullopt;
+        }
+
+        void InsertOrAssign(uint64_t key, uint32_t value)
+        {
+            std::lock_guard guard(mutex_);
+            map_.insert_or_assign(key, value);
+        }
+
+        void Erase(uint64_t key)
+        {
+            std::lock_guard guard(mutex_);
+            map_.erase(key);
+        }
+
+    private:
+        std::mutex mutex_;
+        std::unordered_map<uint64_t, uint32_t> map_;
+    };
+
+    using LockFreeHashMap = lockfree::ConcurrentHashMap<uint64_t, uint32_t>;
+}
+
+// range(0) is the percentage of lookups; the rest is split evenly between assignments and erasures.
+template <class HashMap>
+static void BM_MixedWorkload(benchmark::State& state) {
+    static std::unique_ptr<HashMap> map;
+    const auto readPercentage = static_cast<uint32_t>(state.range(0));
+
+    if (state.thread_index() == 0)
+    {
+        map = std::make_unique<HashMap>();
+        for (uint64_t key = 1; key <= KeysAmount; ++key)
+        {
+            map->InsertOrAssign(key, static_cast<uint32_t>(key));
+        }
+    }
+
+    std::mt19937_64 random(state.thread_index() + 1);
+    std::uniform_int_distribution<uint64_t> keys(1, KeysAmount);
+    std::uniform_int_distribution<uint32_t> percents(0, 99);
+
+    for (auto _ : state)
+    {
+        const auto key = keys(random);
+        const auto percent = percents(random);
+        if (percent < readPercentage)
+        {
+            benchmark::DoNotOptimize(map->Find(key));
+        }
+        else if (percent % 2 == 0)
+        {
+            map->InsertOrAssign(key, percent);
+        }
+        else
+        {
+            map->Erase(key);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_MixedWorkload<MutexHashMap>)->Name("BM_ReadHeavy<MutexHashMap>")->Arg(95)->ThreadRange(1, 4)->UseRealTime();
+BENCHMARK(BM_MixedWorkload<LockFreeHashMap>)->Name("BM_ReadHeavy<ConcurrentHashMap>")->Arg(95)->ThreadRange(1, 4)->UseRealTime();
+BENCHMARK(BM_MixedWorkload<MutexHashMap>)->Name("BM_WriteHeavy<MutexHashMap>")->Arg(20)->ThreadRange(1, 4)->UseRealTime();
+BENCHMARK(BM_MixedWorkload<LockFreeHashMap>)->Name("BM_WriteHeavy<ConcurrentHashMap>")->Arg(20)->ThreadRange(1, 4)->UseRealTime();
+
+BENCHMARK_MAIN();
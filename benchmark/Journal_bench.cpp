@@ -0,0 +1,153 @@
+#include <array>
+#include <filesystem>
+#include <memory>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include <Journal.h>
+#include <SPSCRingBuffer.h>
+
+namespace
+{
+    constexpr std::size_t BufferSize = 1 << 16;
+    constexpr std::size_t SegmentSize = 64 * 1024 * 1024;
+
+    // A typical gateway message: a few ids, a price and a quantity.
+    struct Message
+    {
+        std::array<uint64_t, 8> fields{};
+    };
+
+    std::filesystem::path BenchDirectory()
+    {
+        return std::filesystem::temp_directory_path() / ("journal_bench_" + std::to_string(::getpid()));
+    }
+
+    class RingQueue
+    {
+    public:
+        void Push(const Message& message)
+        {
+            ring_.Push(message);
+        }
+
+        bool Pop()
+        {
+            return ring_.Pop().has_value();
+        }
+
+    private:
+        lockfree::SPSCRingBuffer<Message, BufferSize> ring_;
+    };
+
+    template <journal::Sync Sync>
+    class JournalQueue
+    {
+    public:
+        JournalQueue()
+            : journal_(Options())
+        {
+        }
+
+        ~JournalQueue()
+        {
+            std::filesystem::remove_all(BenchDirectory());
+        }
+
+        void Push(const Message& message)
+        {
+            journal_.Append(message);
+        }
+
+        // Reads the message in place, without copying it out of the mapping.
+        bool Pop()
+        {
+            const auto record = journal_.Peek();
+            if (!record)
+            {
+                return false;
+            }
+
+            benchmark::DoNotOptimize(reinterpret_cast<const Message*>(record->data())->fields[0]);
+            journal_.Consume();
+            return true;
+        }
+
+    private:
+        static journal::Options Options()
+        {
+            std::filesystem::remove_all(BenchDirectory());
+            return {.directory = BenchDirectory(), .segmentSize = SegmentSize, .sync = Sync, .syncEvery = 64};
+        }
+
+        journal::Journal journal_;
+    };
+}
+
+// The producer appends a burst of messages and the consumer drains it, on one thread, so the numbers show the
+// cost of durability rather than of cross-core traffic.
+template <class Queue>
+static void BM_AppendConsume(benchmark::State& state)
+{
+    const auto burst = static_cast<std::size_t>(state.range(0));
+
+    auto queue = std::make_unique<Queue>();
+    Message message;
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < burst; ++i)
+        {
+            message.fields[0] = i;
+            queue->Push(message);
+        }
+        for (std::size_t i = 0; i < burst; ++i)
+        {
+            benchmark::DoNotOptimize(queue->Pop());
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * burst);
+    state.SetBytesProcessed(state.iterations() * burst * sizeof(Message));
+}
+
+// Restart after a crash: open a journal with range(0) pending messages and replay them all.
+static void BM_RecoverAndReplay(benchmark::State& state)
+{
+    const auto pending = static_cast<std::size_t>(state.range(0));
+    const journal::Options options{.directory = BenchDirectory(), .segmentSize = SegmentSize};
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        std::filesystem::remove_all(options.directory);
+        {
+            journal::Journal journal(options);
+            for (std::size_t i = 0; i < pending; ++i)
+            {
+                journal.Append(Message{});
+            }
+        }
+        state.ResumeTiming();
+
+        journal::Journal journal(options);
+        uint64_t sum = 0;
+        journal.Replay([&sum](std::span<const std::byte> record)
+        {
+            sum += reinterpret_cast<const Message*>(record.data())->fields[0];
+        });
+        benchmark::DoNotOptimize(sum);
+    }
+
+    std::filesystem::remove_all(options.directory);
+    state.SetItemsProcessed(state.iterations() * pending);
+}
+
+BENCHMARK(BM_AppendConsume<RingQueue>)->Arg(64);
+BENCHMARK(BM_AppendConsume<JournalQueue<journal::Sync::None>>)->Arg(64);
+BENCHMARK(BM_AppendConsume<JournalQueue<journal::Sync::Msync>>)->Arg(64);
+BENCHMARK(BM_AppendConsume<JournalQueue<journal::Sync::Fdatasync>>)->Arg(64);
+
+BENCHMARK(BM_RecoverAndReplay)->Arg(1 << 16)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+#include <benchmark/benchmark.h>
+
+// Log-linear latency histogram in nanoseconds: every power of two is split into kSubBuckets, so any recorded
+// value is reported with at most 1/kSubBuckets relative error. The maximum is kept exactly.
+class LatencyHistogram
+{
+    static constexpr std::size_t kSubBucketBits = 4;
+    static constexpr std::size_t kSubBuckets = 1 << kSubBucketBits;
+    static constexpr std::size_t kBuckets = 64 * kSubBuckets;
+
+public:
+    void Record(uint64_t nanoseconds)
+    {
+        ++counts_[BucketOf(nanoseconds)];
+        ++total_;
+        max_ = std::max(max_, nanoseconds);
+    }
+
+    void Merge(const LatencyHistogram& other)
+    {
+        for (std::size_t i = 0; i < kBuckets; ++i)
+        {
+            counts_[i] += other.counts_[i];
+        }
+        total_ += other.total_;
+        max_ = std::max(max_, other.max_);
+    }
+
+    // Upper bound of the bucket holding the given percentile.
+    uint64_t Percentile(double percentile) const
+    {
+        const auto rank = static_cast<uint64_t>(static_cast<double>(total_) * percentile / 100.0);
+        uint64_t seen = 0;
+        for (std::size_t i = 0; i < kBuckets; ++i)
+        {
+            seen += counts_[i];
+            if (seen > rank)
+            {
+                return std::min(UpperBoundOf(i), max_);
+            }
+        }
+
+        return max_;
+    }
+
+    uint64_t Max() const
+    {
+        return max_;
+    }
+
+    void Report(benchmark::State& state) const
+    {
+        state.counters["p50_ns"] = static_cast<double>(Percentile(50));
+        state.counters["p99_ns"] = static_cast<double>(Percentile(99));
+        state.counters["p99.9_ns"] = static_cast<double>(Percentile(99.9));
+        state.counters["p99.99_ns"] = static_cast<double>(Percentile(99.99));
+        state.counters["max_ns"] = static_cast<double>(Max());
+    }
+
+private:
+    static std::size_t BucketOf(uint64_t value)
+    {
+        if (value < kSubBuckets)
+        {
+            return value;
+        }
+
+        const auto exponent = static_cast<std::size_t>(std::bit_width(value)) - 1;
+        const auto shift = exponent - kSubBucketBits;
+        const auto subBucket = static_cast<std::size_t>(value >> shift) - kSubBuckets;
+        return (shift + 1) * kSubBuckets + subBucket;
+    }
+
+    static uint64_t UpperBoundOf(std::size_t bucket)
+    {
+        if (bucket < kSubBuckets)
+        {
+            return bucket;
+        }
+
+        const auto shift = bucket / kSubBuckets - 1;
+        const auto subBucket = bucket % kSubBuckets;
+        return ((kSubBuckets + subBucket + 1) << shift) - 1;
+    }
+
+private:
+    std::array<uint64_t, kBuckets> counts_{};
+    uint64_t total_ = 0;
+    uint64_t max_ = 0;
+};
@@ -0,0 +1,94 @@
+#include <array>
+#include <memory>
+#include <mutex>
+
+#include <benchmark/benchmark.h>
+
+#include <BlockingRingBuffer.h>
+#include <Locks.h>
+
+namespace
+{
+    constexpr std::size_t BufferSize = 1 << 16;
+
+    // A few cache lines of work per critical section, roughly what a ring buffer slot update costs.
+    struct Counters
+    {
+        std::array<long long, 16> values{};
+    };
+
+    template <class Lock>
+    struct Shared
+    {
+        Lock lock;
+        Counters counters;
+    };
+}
+
+template <class Lock>
+static void BM_CriticalSection(benchmark::State& state)
+{
+    static std::unique_ptr<Shared<Lock>> shared;
+
+    if (state.thread_index() == 0)
+    {
+        shared = std::make_unique<Shared<Lock>>();
+    }
+
+    for (auto _ : state)
+    {
+        std::lock_guard guard(shared->lock);
+        for (auto& value : shared->counters.values)
+        {
+            ++value;
+        }
+        benchmark::ClobberMemory();
+    }
+
+    if (state.thread_index() == 0)
+    {
+        shared.reset();
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+template <class Lock>
+static void BM_LockedRingBufferPushPop(benchmark::State& state)
+{
+    static std::unique_ptr<blocking::BlockingRingBuffer<int, BufferSize, Lock>> buffer;
+
+    if (state.thread_index() == 0)
+    {
+        buffer = std::make_unique<blocking::BlockingRingBuffer<int, BufferSize, Lock>>();
+    }
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(buffer->Push(1));
+        benchmark::DoNotOptimize(buffer->Pop());
+    }
+
+    if (state.thread_index() == 0)
+    {
+        buffer.reset();
+    }
+
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+
+BENCHMARK(BM_CriticalSection<std::mutex>)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(BM_CriticalSection<blocking::TTASLock>)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(BM_CriticalSection<blocking::TicketLock>)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(BM_CriticalSection<blocking::MCSLock>)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(BM_CriticalSection<blocking::CLHLock>)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(BM_CriticalSection<blocking::HybridLock>)->ThreadRange(1, 16)->UseRealTime();
+
+BENCHMARK(BM_LockedRingBufferPushPop<std::mutex>)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(BM_LockedRingBufferPushPop<blocking::TTASLock>)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(BM_LockedRingBufferPushPop<blocking::TicketLock>)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(BM_LockedRingBufferPushPop<blocking::MCSLock>)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(BM_LockedRingBufferPushPop<blocking::CLHLock>)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(BM_LockedRingBufferPushPop<blocking::HybridLock>)->ThreadRange(1, 16)->UseRealTime();
+
+BENCHMARK_MAIN();
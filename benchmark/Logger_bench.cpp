@@ -0,0 +1,68 @@
+#include <cstdio>
+#include <memory>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <benchmark/benchmark.h>
+
+#include <Logger.h>
+
+// Cost of one log call on the hot thread. The background thread writes to /dev/null, so only the producer
+// side and its interference with the formatter are measured.
+template <logging::FullPolicy Policy>
+static void BM_LogCall(benchmark::State& state) {
+    using Logger = logging::Logger<Policy>;
+    static std::unique_ptr<Logger> logger;
+
+    if (state.thread_index() == 0)
+    {
+        logger = std::make_unique<Logger>(logging::Options{.path = "/dev/null"});
+    }
+
+    long long order = 0;
+    for (auto _ : state)
+    {
+        LOGGING_INFO(*logger, "order {} price {} side {}", ++order, 101.25, "buy");
+    }
+
+    if (state.thread_index() == 0)
+    {
+        state.counters["dropped"] = benchmark::Counter(static_cast<double>(logger->Dropped()));
+        logger.reset();
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+// What the hot threads do today: format in place and write the line with a syscall.
+static void BM_InlineWrite(benchmark::State& state) {
+    static int fd = -1;
+
+    if (state.thread_index() == 0)
+    {
+        fd = ::open("/dev/null", O_WRONLY);
+    }
+
+    long long order = 0;
+    for (auto _ : state)
+    {
+        char line[128];
+        const auto size = std::snprintf(line, sizeof(line), "INFO order %lld price %g side %s\n", ++order, 101.25, "buy");
+        benchmark::DoNotOptimize(::write(fd, line, static_cast<std::size_t>(size)));
+    }
+
+    if (state.thread_index() == 0)
+    {
+        ::close(fd);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_LogCall<logging::FullPolicy::Drop>)->ThreadRange(1, 4)->UseRealTime();
+BENCHMARK(BM_LogCall<logging::FullPolicy::Block>)->ThreadRange(1, 4)->UseRealTime();
+BENCHMARK(BM_LogCall<logging::FullPolicy::Overwrite>)->ThreadRange(1, 4)->UseRealTime();
+BENCHMARK(BM_InlineWrite)->ThreadRange(1, 4)->UseRealTime();
+
+BENCHMARK_MAIN();
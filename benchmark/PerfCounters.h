@@ -0,0 +1,158 @@
+#pragma once
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <benchmark/benchmark.h>
+
+// Hardware counters for the calling thread and every thread it starts after construction (perf "inherit"),
+// read through perf_event_open. Each counter is opened on its own, so whatever the CPU or the
+// perf_event_paranoid setting does not permit is simply left out of the report; when nothing can be opened the
+// benchmark runs exactly as before. Counts are scaled for multiplexing.
+//
+// There is no generic event for cross-core HITM snoops. Set PERF_HITM_RAW to the raw event of the machine,
+// e.g. 0x04d2 (MEM_LOAD_L3_HIT_RETIRED.XSNP_HITM) on Skylake-era Intel cores, to get a "HITM" counter.
+class PerfCounters
+{
+    struct Counter
+    {
+        std::string name;
+        int fd;
+    };
+
+    struct ReadFormat
+    {
+        uint64_t value;
+        uint64_t timeEnabled;
+        uint64_t timeRunning;
+    };
+
+public:
+    PerfCounters()
+    {
+        Open("cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+        Open("instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+        Open("L1D-misses", PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+        Open("LLC-misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+        Open("branch-misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+        if (const auto* hitm = std::getenv("PERF_HITM_RAW"))
+        {
+            Open("HITM", PERF_TYPE_RAW, std::strtoull(hitm, nullptr, 0));
+        }
+
+        if (counters_.empty())
+        {
+            WarnOnce();
+        }
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    ~PerfCounters()
+    {
+        for (const auto& counter : counters_)
+        {
+            close(counter.fd);
+        }
+    }
+
+    void Start()
+    {
+        for (const auto& counter : counters_)
+        {
+            ioctl(counter.fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+
+    void Stop()
+    {
+        for (const auto& counter : counters_)
+        {
+            ioctl(counter.fd, PERF_EVENT_IOC_DISABLE, 0);
+        }
+    }
+
+    // Adds every counter, divided by `items`, plus IPC.
+    void Report(benchmark::State& state, uint64_t items) const
+    {
+        if (items == 0)
+        {
+            return;
+        }
+
+        double cycles = 0;
+        double instructions = 0;
+        for (const auto& counter : counters_)
+        {
+            ReadFormat data{};
+            if (read(counter.fd, &data, sizeof(data)) != sizeof(data) || data.timeRunning == 0)
+            {
+                continue;
+            }
+
+            const auto value = static_cast<double>(data.value) * static_cast<double>(data.timeEnabled) / static_cast<double>(data.timeRunning);
+            state.counters[counter.name + "/item"] = value / static_cast<double>(items);
+            if (counter.name == "cycles")
+            {
+                cycles = value;
+            }
+            else if (counter.name == "instructions")
+            {
+                instructions = value;
+            }
+        }
+
+        if (cycles > 0 && instructions > 0)
+        {
+            state.counters["IPC"] = instructions / cycles;
+        }
+    }
+
+private:
+    void Open(const char* name, uint32_t type, uint64_t config)
+    {
+        perf_event_attr attr{};
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.disabled = 1;
+        attr.inherit = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        const auto fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+        if (fd < 0)
+        {
+            error_ = errno;
+            return;
+        }
+
+        counters_.push_back(Counter{name, fd});
+    }
+
+    void WarnOnce() const
+    {
+        static bool warned = false;
+        if (!warned)
+        {
+            warned = true;
+            std::cerr << "perf counters unavailable (" << std::strerror(error_) << "), reporting time only\n";
+        }
+    }
+
+private:
+    std::vector<Counter> counters_;
+    int error_ = 0;
+};
@@ -0,0 +1,93 @@
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <MPMCRingBuffer.h>
+#include <MSQueue.h>
+#include <WaitFreeQueue.h>
+
+#include "LatencyHistogram.h"
+
+namespace
+{
+    constexpr std::size_t BufferSize = 1ULL << 16;
+    template <class T>
+    using MPMCLFRingBuffer = lockfree::MPMCRingBuffer<T, BufferSize>;
+    template <class T>
+    using WaitFreeQueue = lockfree::WaitFreeQueue<T>;
+
+    uint64_t Elapsed(std::chrono::steady_clock::time_point start)
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+    }
+}
+
+// Every thread alternates Push and Pop on one shared queue and times each call on its own. The counters are
+// percentiles over all calls of all threads; the tail is what this benchmark is about, not the mean.
+template <template <typename...> class Queue>
+static void BM_OperationLatency(benchmark::State& state) {
+    const auto operationsPerThread = static_cast<std::size_t>(state.range(0));
+    const auto threadsAmount = static_cast<std::size_t>(state.range(1));
+
+    LatencyHistogram pushes;
+    LatencyHistogram pops;
+
+    for (auto _ : state)
+    {
+        Queue<int> queue;
+        std::vector<LatencyHistogram> threadPushes(threadsAmount);
+        std::vector<LatencyHistogram> threadPops(threadsAmount);
+
+        {
+            std::vector<std::jthread> threads;
+            for (std::size_t t = 0; t < threadsAmount; ++t)
+            {
+                threads.emplace_back([&queue, &push = threadPushes[t], &pop = threadPops[t], operationsPerThread]()
+                {
+                    for (std::size_t i = 0; i < operationsPerThread; ++i)
+                    {
+                        auto start = std::chrono::steady_clock::now();
+                        queue.Push(static_cast<int>(i));
+                        push.Record(Elapsed(start));
+
+                        start = std::chrono::steady_clock::now();
+                        benchmark::DoNotOptimize(queue.Pop());
+                        pop.Record(Elapsed(start));
+                    }
+                });
+            }
+        }
+
+        for (std::size_t t = 0; t < threadsAmount; ++t)
+        {
+            pushes.Merge(threadPushes[t]);
+            pops.Merge(threadPops[t]);
+        }
+    }
+
+    pushes.Merge(pops);
+    pushes.Report(state);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * operationsPerThread * threadsAmount * 2));
+}
+
+BENCHMARK(BM_OperationLatency<WaitFreeQueue>)->ArgsProduct(
+{
+    {100'000},
+    benchmark::CreateDenseRange(1, 4, 1)
+})->UseRealTime();
+
+BENCHMARK(BM_OperationLatency<lockfree::MSQueue>)->ArgsProduct(
+{
+    {100'000},
+    benchmark::CreateDenseRange(1, 4, 1)
+})->UseRealTime();
+
+BENCHMARK(BM_OperationLatency<MPMCLFRingBuffer>)->ArgsProduct(
+{
+    {100'000},
+    benchmark::CreateDenseRange(1, 4, 1)
+})->UseRealTime();
+
+BENCHMARK_MAIN();
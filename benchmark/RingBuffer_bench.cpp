@@ -4,9 +4,17 @@
 
 #include <benchmark/benchmark.h>
 
+#include "PerfCounters.h"
+
+#include <BatchedSPSCRingBuffer.h>
 #include <BlockingRingBuffer.h>
+#include <IntrusiveMPSCQueue.h>
 #include <MPMCRingBuffer.h>
+#include <MSQueue.h>
+#include <NodeAllocator.h>
 #include <SPSCRingBuffer.h>
+#include <StripedCounter.h>
+#include <Topology.h>
 
 namespace
 {
@@ -16,7 +24,78 @@ namespace
     template <class T>
     using SPSCLFRingBuffer = lockfree::SPSCRingBuffer<T, BufferSize>;
     template <class T>
+    using BatchedSPSCLFRingBuffer = lockfree::BatchedSPSCRingBuffer<T, BufferSize>;
+    template <class T>
     using MPMCLFRingBuffer = lockfree::MPMCRingBuffer<T, BufferSize>;
+    template <class T>
+    using SPSCNumaRingBuffer = lockfree::SPSCRingBuffer<T, BufferSize, numa::NodeAllocator<T>, numa::kPageSize>;
+    template <class T>
+    using MPMCNumaRingBuffer = lockfree::MPMCRingBuffer<T, BufferSize, numa::NodeAllocator<T>>;
+
+    struct Message : lockfree::MPSCQueueHook
+    {
+        std::size_t value = 0;
+    };
+
+    // Both mailboxes get preallocated messages; MSQueue still allocates a node of its own per Push.
+    class MSQueueMailbox
+    {
+    public:
+        void Push(Message* message)
+        {
+            queue_.Push(message);
+        }
+
+        bool Pop()
+        {
+            return queue_.Pop().has_value();
+        }
+
+    private:
+        lockfree::MSQueue<Message*> queue_;
+    };
+
+    class IntrusiveMailbox
+    {
+    public:
+        void Push(Message* message)
+        {
+            queue_.Push(message);
+        }
+
+        bool Pop()
+        {
+            return queue_.Pop() != nullptr;
+        }
+
+    private:
+        lockfree::IntrusiveMPSCQueue<Message> queue_;
+    };
+
+    // The SPSC buffer keeps its consumer's index words on the first page of the object, move that page over.
+    template <class T, std::size_t Capacity, class Allocator>
+    void BindConsumerIndexes(lockfree::SPSCRingBuffer<T, Capacity, Allocator, numa::kPageSize>& buffer, int consumerNode)
+    {
+        numa::BindToNode(&buffer, numa::kPageSize, consumerNode);
+    }
+
+    // Every index word of an MPMC buffer is written by both sides, they stay on the producer's node.
+    template <class RingBuffer>
+    void BindConsumerIndexes(RingBuffer&, int)
+    {
+    }
+
+    constexpr const char* PlacementName(numa::Placement placement)
+    {
+        switch (placement)
+        {
+            case numa::Placement::SameCore: return "same-core";
+            case numa::Placement::SameSocket: return "same-socket";
+            case numa::Placement::CrossSocket: return "cross-socket";
+        }
+
+        return "";
+    }
 }
 
 template <template <typename...> class RingBuffer>
@@ -31,6 +110,8 @@ static void BM_ConcurrentPushPop(benchmark::State& state) {
     RingBuffer<int> buffer;
     benchmark::DoNotOptimize(buffer);
 
+    PerfCounters perf;
+    perf.Start();
     for (auto _ : state)
     {
         state.PauseTiming();
@@ -43,7 +124,7 @@ static void BM_ConcurrentPushPop(benchmark::State& state) {
             buffer.Push(i);
         }
 
-        std::atomic<std::size_t> popped = 0;
+        lockfree::StripedCounter popped;
 
         for (auto & producer : producers)
         {
@@ -54,6 +135,11 @@ static void BM_ConcurrentPushPop(benchmark::State& state) {
                    while (!buffer.Push(i)) {}
                    benchmark::ClobberMemory();
                }
+
+               if constexpr (requires { buffer.Flush(); })
+               {
+                   buffer.Flush();
+               }
             });
         }
 
@@ -61,21 +147,121 @@ static void BM_ConcurrentPushPop(benchmark::State& state) {
         {
             consumer = std::jthread([&buffer, &popped, totalAmount]()
             {
-                while (popped.load(std::memory_order_relaxed) < totalAmount)
+                // Summing the stripes is the expensive part, so only look at the total once the buffer runs dry.
+                while (true)
                 {
                     if (buffer.Pop())
                     {
                         using namespace std::chrono_literals;
                         std::this_thread::sleep_for(1ns);
-                        popped.fetch_add(1, std::memory_order_relaxed);
+                        popped.Increment();
                         benchmark::ClobberMemory();
                     }
+                    else if (popped.Load() >= totalAmount)
+                    {
+                        break;
+                    }
                 }
             });
         }
 
         benchmark::ClobberMemory();
     }
+    perf.Stop();
+    perf.Report(state, state.iterations() * totalAmount);
+}
+
+// One pinned producer and one pinned consumer. The slots are bound to the consumer's node and the buffer to
+// the producer's node, except for the SPSC consumer's index page, which goes to the consumer's node.
+template <template <typename...> class RingBuffer>
+static void BM_PinnedPushPop(benchmark::State& state) {
+    const auto amount = static_cast<std::size_t>(state.range(0));
+    const auto placement = static_cast<numa::Placement>(state.range(1));
+
+    const auto pair = numa::FindPair(placement);
+    if (!pair)
+    {
+        const auto message = std::string("no ") + PlacementName(placement) + " CPU pair on this machine";
+        state.SkipWithError(message.c_str());
+        return;
+    }
+
+    const auto [producerCpu, consumerCpu] = *pair;
+    auto buffer = numa::MakeOnNode<RingBuffer<int>>(producerCpu.node, numa::NodeAllocator<int>(consumerCpu.node));
+    BindConsumerIndexes(*buffer, consumerCpu.node);
+
+    PerfCounters perf;
+    perf.Start();
+    for (auto _ : state)
+    {
+        std::jthread consumer([&buffer, amount, cpu = consumerCpu.id]()
+        {
+            numa::PinCurrentThread(cpu);
+            for (std::size_t i = 0; i < amount; ++i)
+            {
+                while (!buffer->Pop()) {}
+                benchmark::ClobberMemory();
+            }
+        });
+
+        std::jthread producer([&buffer, amount, cpu = producerCpu.id]()
+        {
+            numa::PinCurrentThread(cpu);
+            for (std::size_t i = 0; i < amount; ++i)
+            {
+                while (!buffer->Push(i)) {}
+                benchmark::ClobberMemory();
+            }
+        });
+    }
+
+    perf.Stop();
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * amount));
+    perf.Report(state, state.iterations() * amount);
+    state.SetLabel(PlacementName(placement));
+}
+
+// Many producers and a single consumer, as in an actor mailbox.
+template <class Mailbox>
+static void BM_MailboxPushPop(benchmark::State& state) {
+    const auto amountPerThread = static_cast<std::size_t>(state.range(0));
+    const auto producersAmount = static_cast<std::size_t>(state.range(1));
+    const auto totalAmount = amountPerThread * producersAmount;
+
+    std::vector<Message> messages(totalAmount);
+
+    PerfCounters perf;
+    perf.Start();
+    for (auto _ : state)
+    {
+        Mailbox mailbox;
+        std::vector<std::jthread> producers;
+        for (std::size_t p = 0; p < producersAmount; ++p)
+        {
+            producers.emplace_back([&mailbox, &messages, amountPerThread, p]()
+            {
+                for (std::size_t i = p * amountPerThread; i < (p + 1) * amountPerThread; ++i)
+                {
+                    mailbox.Push(&messages[i]);
+                }
+            });
+        }
+
+        std::size_t popped = 0;
+        while (popped < totalAmount)
+        {
+            if (mailbox.Pop())
+            {
+                ++popped;
+            }
+        }
+    }
+
+    perf.Stop();
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * totalAmount));
+    perf.Report(state, state.iterations() * totalAmount);
 }
 
 BENCHMARK(BM_ConcurrentPushPop<BlockingRingBuffer>)->ArgsProduct(
@@ -94,6 +280,13 @@ BENCHMARK(BM_ConcurrentPushPop<SPSCLFRingBuffer>)->ArgsProduct(
     benchmark::CreateDenseRange(1, 1, 1)}
 );
 
+BENCHMARK(BM_ConcurrentPushPop<BatchedSPSCLFRingBuffer>)->ArgsProduct(
+{
+    {1'000'000},
+    benchmark::CreateDenseRange(1, 1, 1),
+    benchmark::CreateDenseRange(1, 1, 1)}
+);
+
 BENCHMARK(BM_ConcurrentPushPop<MPMCLFRingBuffer>)->ArgsProduct(
 {
     //benchmark::CreateRange(1, 1'000'000, 10),
@@ -102,4 +295,36 @@ BENCHMARK(BM_ConcurrentPushPop<MPMCLFRingBuffer>)->ArgsProduct(
     benchmark::CreateDenseRange(1, 3, 2)
 });
 
+BENCHMARK(BM_PinnedPushPop<SPSCNumaRingBuffer>)->ArgsProduct(
+{
+    {1'000'000},
+    {
+        static_cast<int>(numa::Placement::SameCore),
+        static_cast<int>(numa::Placement::SameSocket),
+        static_cast<int>(numa::Placement::CrossSocket)
+    }
+})->UseRealTime();
+
+BENCHMARK(BM_PinnedPushPop<MPMCNumaRingBuffer>)->ArgsProduct(
+{
+    {1'000'000},
+    {
+        static_cast<int>(numa::Placement::SameCore),
+        static_cast<int>(numa::Placement::SameSocket),
+        static_cast<int>(numa::Placement::CrossSocket)
+    }
+})->UseRealTime();
+
+BENCHMARK(BM_MailboxPushPop<MSQueueMailbox>)->ArgsProduct(
+{
+    {1'000'000},
+    benchmark::CreateDenseRange(1, 4, 1)
+})->UseRealTime();
+
+BENCHMARK(BM_MailboxPushPop<IntrusiveMailbox>)->ArgsProduct(
+{
+    {1'000'000},
+    benchmark::CreateDenseRange(1, 4, 1)
+})->UseRealTime();
+
 BENCHMARK_MAIN();
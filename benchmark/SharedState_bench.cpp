@@ -0,0 +1,142 @@
+#include <array>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+
+#include <benchmark/benchmark.h>
+
+#include <Publisher.h>
+#include <SeqLock.h>
+
+namespace
+{
+    struct Limits
+    {
+        std::array<long long, 6> values{};
+    };
+
+    Limits MakeLimits(long long version)
+    {
+        Limits limits;
+        limits.values.fill(version);
+        return limits;
+    }
+
+    class MutexState
+    {
+    public:
+        long long Read()
+        {
+            std::lock_guard guard(mutex_);
+            return limits_.values[0] + limits_.values[5];
+        }
+
+        void Write(long long version)
+        {
+            std::lock_guard guard(mutex_);
+            limits_ = MakeLimits(version);
+        }
+
+    private:
+        std::mutex mutex_;
+        Limits limits_;
+    };
+
+    class SharedMutexState
+    {
+    public:
+        long long Read()
+        {
+            std::shared_lock guard(mutex_);
+            return limits_.values[0] + limits_.values[5];
+        }
+
+        void Write(long long version)
+        {
+            std::unique_lock guard(mutex_);
+            limits_ = MakeLimits(version);
+        }
+
+    private:
+        std::shared_mutex mutex_;
+        Limits limits_;
+    };
+
+    class SeqLockState
+    {
+    public:
+        long long Read()
+        {
+            const auto limits = lock_.Load();
+            return limits.values[0] + limits.values[5];
+        }
+
+        void Write(long long version)
+        {
+            lock_.Store(MakeLimits(version));
+        }
+
+    private:
+        lockfree::SeqLock<Limits> lock_;
+    };
+
+    class PublisherState
+    {
+    public:
+        long long Read()
+        {
+            const auto snapshot = publisher_.Read();
+            return snapshot->values[0] + snapshot->values[5];
+        }
+
+        void Write(long long version)
+        {
+            publisher_.Emplace(MakeLimits(version));
+        }
+
+    private:
+        lockfree::Publisher<Limits> publisher_{std::make_unique<const Limits>()};
+    };
+}
+
+// Every benchmark thread only reads; a background writer replaces the state every 100us.
+template <class State>
+static void BM_ReaderScaling(benchmark::State& state) {
+    static std::unique_ptr<State> shared;
+    static std::jthread writer;
+
+    if (state.thread_index() == 0)
+    {
+        shared = std::make_unique<State>();
+        writer = std::jthread([](std::stop_token stop)
+        {
+            for (long long version = 1; !stop.stop_requested(); ++version)
+            {
+                shared->Write(version);
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+            }
+        });
+    }
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(shared->Read());
+    }
+
+    if (state.thread_index() == 0)
+    {
+        writer = {};
+        shared.reset();
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_ReaderScaling<MutexState>)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_ReaderScaling<SharedMutexState>)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_ReaderScaling<SeqLockState>)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_ReaderScaling<PublisherState>)->ThreadRange(1, 8)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,117 @@
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <SlotAllocator.h>
+
+namespace
+{
+    constexpr std::size_t TableSize = 1 << 16;
+    constexpr std::size_t Burst = 16;
+
+    // The usual free list: a Treiber stack threaded through a next-index array. The head carries a 32-bit
+    // tag bumped by every change, so a popper that read a stale next index cannot succeed (ABA), and the
+    // array is never freed, so reading a next index that was just reused is harmless.
+    class StackSlots
+    {
+        static constexpr uint32_t kNil = UINT32_MAX;
+
+    public:
+        StackSlots()
+        {
+            for (std::size_t i = 0; i < TableSize; ++i)
+            {
+                next_[i].store(i + 1 < TableSize ? static_cast<uint32_t>(i + 1) : kNil, std::memory_order_relaxed);
+            }
+            head_.store(0, std::memory_order_relaxed);
+        }
+
+        std::size_t Allocate(std::span<std::size_t> out)
+        {
+            std::size_t allocated = 0;
+            for (; allocated < out.size(); ++allocated)
+            {
+                auto head = head_.load(std::memory_order_acquire);
+                while (true)
+                {
+                    const auto index = static_cast<uint32_t>(head);
+                    if (index == kNil)
+                    {
+                        return allocated;
+                    }
+
+                    const auto next = next_[index].load(std::memory_order_relaxed);
+                    if (head_.compare_exchange_weak(head, Tagged(head, next), std::memory_order_acquire, std::memory_order_acquire))
+                    {
+                        out[allocated] = index;
+                        break;
+                    }
+                }
+            }
+            return allocated;
+        }
+
+        void Free(std::span<const std::size_t> indexes)
+        {
+            for (const auto index : indexes)
+            {
+                auto head = head_.load(std::memory_order_relaxed);
+                do
+                {
+                    next_[index].store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+                }
+                while (!head_.compare_exchange_weak(head, Tagged(head, static_cast<uint32_t>(index)), std::memory_order_release, std::memory_order_relaxed));
+            }
+        }
+
+    private:
+        static uint64_t Tagged(uint64_t head, uint32_t index)
+        {
+            return (((head >> 32) + 1) << 32) | index;
+        }
+
+        std::atomic<uint64_t> head_;
+        std::vector<std::atomic<uint32_t>> next_ = std::vector<std::atomic<uint32_t>>(TableSize);
+    };
+
+    using BitmapSlots = lockfree::SlotAllocator<TableSize>;
+}
+
+// Session setup and teardown: every iteration takes Amount slots and gives them back.
+template <class Slots, std::size_t Amount>
+static void BM_AllocateFree(benchmark::State& state)
+{
+    static std::unique_ptr<Slots> shared;
+
+    if (state.thread_index() == 0)
+    {
+        shared = std::make_unique<Slots>();
+    }
+
+    std::array<std::size_t, Amount> held{};
+    for (auto _ : state)
+    {
+        const auto amount = shared->Allocate(held);
+        benchmark::DoNotOptimize(held);
+        shared->Free(std::span<const std::size_t>(held.data(), amount));
+    }
+
+    if (state.thread_index() == 0)
+    {
+        shared.reset();
+    }
+
+    state.SetItemsProcessed(state.iterations() * Amount);
+}
+
+BENCHMARK(BM_AllocateFree<StackSlots, 1>)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(BM_AllocateFree<BitmapSlots, 1>)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(BM_AllocateFree<StackSlots, Burst>)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(BM_AllocateFree<BitmapSlots, Burst>)->ThreadRange(1, 16)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,171 @@
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <TimingWheel.h>
+
+namespace
+{
+    using Milliseconds = uint64_t;
+
+    // What services do today: a min-heap under a mutex, with lazy cancellation.
+    class HeapTimers
+    {
+        struct Entry
+        {
+            Milliseconds expiry;
+            uint64_t id;
+
+            bool operator>(const Entry& other) const
+            {
+                return expiry > other.expiry;
+            }
+        };
+
+    public:
+        uint64_t Schedule(Milliseconds delay, timer::Task task)
+        {
+            std::lock_guard guard(mutex_);
+            const auto id = next_id_++;
+            heap_.push(Entry{now_ + delay, id});
+            tasks_.emplace(id, std::move(task));
+            return id;
+        }
+
+        bool Cancel(uint64_t id)
+        {
+            std::lock_guard guard(mutex_);
+            return tasks_.erase(id) > 0;
+        }
+
+        std::size_t Advance(Milliseconds now)
+        {
+            std::lock_guard guard(mutex_);
+            now_ = now;
+            std::size_t fired = 0;
+            while (!heap_.empty() && heap_.top().expiry <= now_)
+            {
+                const auto node = tasks_.extract(heap_.top().id);
+                heap_.pop();
+                if (!node.empty())
+                {
+                    node.mapped()();
+                    ++fired;
+                }
+            }
+            return fired;
+        }
+
+    private:
+        std::mutex mutex_;
+        Milliseconds now_ = 0;
+        uint64_t next_id_ = 0;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<>> heap_;
+        std::unordered_map<uint64_t, timer::Task> tasks_;
+    };
+
+    class WheelTimers
+    {
+    public:
+        timer::TimerId Schedule(Milliseconds delay, timer::Task task)
+        {
+            return wheel_.Schedule(std::chrono::milliseconds(delay), std::move(task));
+        }
+
+        bool Cancel(timer::TimerId id)
+        {
+            return wheel_.Cancel(id);
+        }
+
+        std::size_t Advance(Milliseconds now)
+        {
+            return wheel_.Advance(timer::Clock::time_point{} + std::chrono::milliseconds(now));
+        }
+
+    private:
+        timer::TimingWheel<> wheel_{std::chrono::milliseconds(1), timer::Clock::time_point{}};
+    };
+
+    template <class Timers>
+    void Prefill(Timers& timers, std::size_t amount, std::mt19937_64& random)
+    {
+        std::uniform_int_distribution<Milliseconds> delay(60'000, 3'600'000);
+        for (std::size_t i = 0; i < amount; ++i)
+        {
+            timers.Schedule(delay(random), []() {});
+        }
+    }
+}
+
+// Insert and cancel one timer next to `range(0)` pending ones.
+template <class Timers>
+static void BM_ScheduleCancel(benchmark::State& state) {
+    std::mt19937_64 random(42);
+    Timers timers;
+    Prefill(timers, static_cast<std::size_t>(state.range(0)), random);
+
+    std::uniform_int_distribution<Milliseconds> delay(1, 3'600'000);
+    for (auto _ : state)
+    {
+        const auto id = timers.Schedule(delay(random), []() {});
+        benchmark::DoNotOptimize(timers.Cancel(id));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Connection timeouts: every millisecond `range(1)` connections arm a 1s timeout, most of them are cancelled
+// when their request completes 5ms later, the rest expire. One iteration is one millisecond of wall time.
+template <class Timers>
+static void BM_ConnectionTimeouts(benchmark::State& state) {
+    constexpr Milliseconds timeout = 1'000;
+    constexpr Milliseconds completion = 5;
+
+    std::mt19937_64 random(42);
+    Timers timers;
+    Prefill(timers, static_cast<std::size_t>(state.range(0)), random);
+
+    const auto perTick = static_cast<std::size_t>(state.range(1));
+    std::vector<std::vector<decltype(timers.Schedule(0, {}))>> armed(completion + 1);
+    std::size_t expired = 0;
+    Milliseconds now = 0;
+
+    for (auto _ : state)
+    {
+        ++now;
+        auto& completed = armed[now % armed.size()];
+        for (std::size_t i = 0; i < completed.size(); ++i)
+        {
+            // One in ten requests times out.
+            if (i % 10 != 0)
+            {
+                timers.Cancel(completed[i]);
+            }
+        }
+        completed.clear();
+
+        for (std::size_t i = 0; i < perTick; ++i)
+        {
+            completed.push_back(timers.Schedule(timeout, [&expired]() { ++expired; }));
+        }
+
+        benchmark::DoNotOptimize(timers.Advance(now));
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * perTick));
+    state.counters["expired"] = benchmark::Counter(static_cast<double>(expired));
+}
+
+BENCHMARK(BM_ScheduleCancel<HeapTimers>)->RangeMultiplier(8)->Range(1 << 16, 1 << 22);
+BENCHMARK(BM_ScheduleCancel<WheelTimers>)->RangeMultiplier(8)->Range(1 << 16, 1 << 22);
+
+BENCHMARK(BM_ConnectionTimeouts<HeapTimers>)->ArgsProduct({{1 << 20, 1 << 22}, {300}});
+BENCHMARK(BM_ConnectionTimeouts<WheelTimers>)->ArgsProduct({{1 << 20, 1 << 22}, {300}});
+
+BENCHMARK_MAIN();
@@ -4,6 +4,7 @@
 #include <mutex>
 #include <optional>
 #include <utility>
+#include <vector>
 
 namespace blocking
 {
@@ -15,7 +16,8 @@ namespace blocking
         }
     }
 
-    template <class T, std::size_t Size>
+    // Lock is any BasicLockable type, e.g. std::mutex or one of the spinning locks from Locks.h.
+    template <class T, std::size_t Size, class Lock = std::mutex>
     class BlockingRingBuffer
     {
         static_assert(detail::IsPowerOf2(Size), "Size must be a power of 2");
@@ -23,7 +25,7 @@ namespace blocking
     public:
         bool Push(T data)
         {
-            std::lock_guard guard(mutex_);
+            std::lock_guard guard(lock_);
             if (tail_ - head_ == Size)
             {
                 return false;
@@ -35,7 +37,7 @@ namespace blocking
 
         std::optional<T> Pop()
         {
-            std::lock_guard guard(mutex_);
+            std::lock_guard guard(lock_);
             if (head_ == tail_)
             {
                 return std::nullopt;
@@ -51,7 +53,7 @@ namespace blocking
         }
 
     private:
-        std::mutex mutex_;
+        Lock lock_;
         std::size_t head_{0};
         std::size_t tail_{0};
         std::vector<T> data_ = std::vector<T>(Size);
@@ -0,0 +1,317 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <Alignment.h>
+#include <CpuRelax.h>
+
+// Spinning locks for very short critical sections, usable as the Lock parameter of BlockingRingBuffer or with
+// std::lock_guard. Every spin loop yields the CPU after a while, so an oversubscribed machine still makes
+// progress when the lock holder has been preempted.
+namespace blocking
+{
+    namespace detail
+    {
+        class SpinWait
+        {
+            static constexpr uint32_t kSpinsBeforeYield = 128;
+
+        public:
+            void Wait()
+            {
+                if (spins_ < kSpinsBeforeYield)
+                {
+                    ++spins_;
+                    cpu::Relax();
+                }
+                else
+                {
+                    std::this_thread::yield();
+                }
+            }
+
+        private:
+            uint32_t spins_ = 0;
+        };
+
+        // Queue nodes of one thread, reused across acquisitions of any lock of the same type.
+        template <class Node>
+        class NodePool
+        {
+        public:
+            static Node* Take()
+            {
+                auto& pool = Nodes();
+                if (pool.empty())
+                {
+                    return new Node;
+                }
+
+                auto* node = pool.back().release();
+                pool.pop_back();
+                return node;
+            }
+
+            static void Give(Node* node)
+            {
+                Nodes().emplace_back(node);
+            }
+
+        private:
+            static std::vector<std::unique_ptr<Node>>& Nodes()
+            {
+                thread_local std::vector<std::unique_ptr<Node>> nodes;
+                return nodes;
+            }
+        };
+    }
+
+    // Test-and-test-and-set: waiters spin on a plain load and only attempt the exchange once the lock looks
+    // free, backing off exponentially after every lost race.
+    class TTASLock
+    {
+        static constexpr uint32_t kMaxBackoff = 1024;
+
+    public:
+        void lock()
+        {
+            uint32_t backoff = 1;
+            while (true)
+            {
+                detail::SpinWait wait;
+                while (locked_.load(std::memory_order_relaxed))
+                {
+                    wait.Wait();
+                }
+
+                if (!locked_.exchange(true, std::memory_order_acquire))
+                {
+                    return;
+                }
+
+                for (uint32_t i = 0; i < backoff; ++i)
+                {
+                    cpu::Relax();
+                }
+                backoff = backoff < kMaxBackoff ? backoff * 2 : kMaxBackoff;
+            }
+        }
+
+        bool try_lock()
+        {
+            return !locked_.load(std::memory_order_relaxed) && !locked_.exchange(true, std::memory_order_acquire);
+        }
+
+        void unlock()
+        {
+            locked_.store(false, std::memory_order_release);
+        }
+
+    private:
+        std::atomic<bool> locked_{false};
+    };
+
+    // FIFO lock: one fetch_add to draw a ticket, then every waiter polls the same "now serving" word, pausing
+    // in proportion to its distance from the head of the line.
+    class TicketLock
+    {
+    public:
+        void lock()
+        {
+            const auto ticket = next_.fetch_add(1, std::memory_order_relaxed);
+            detail::SpinWait wait;
+            while (true)
+            {
+                const auto serving = serving_.load(std::memory_order_acquire);
+                if (serving == ticket)
+                {
+                    return;
+                }
+
+                for (uint32_t i = 1; i < ticket - serving; ++i)
+                {
+                    cpu::Relax();
+                }
+                wait.Wait();
+            }
+        }
+
+        void unlock()
+        {
+            serving_.store(serving_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        }
+
+    private:
+        alignas(alignment::hardware_destructive_interference_size) std::atomic<uint32_t> next_{0};
+        alignas(alignment::hardware_destructive_interference_size) std::atomic<uint32_t> serving_{0};
+    };
+
+    // Mellor-Crummey-Scott queue lock: every waiter spins on a flag in its own node, and the holder hands the
+    // lock to its successor directly, so a release touches a single remote cache line.
+    class MCSLock
+    {
+        struct alignas(alignment::hardware_destructive_interference_size) Node
+        {
+            std::atomic<Node*> next{nullptr};
+            std::atomic<bool> locked{false};
+        };
+
+    public:
+        void lock()
+        {
+            auto* node = detail::NodePool<Node>::Take();
+            node->next.store(nullptr, std::memory_order_relaxed);
+            node->locked.store(true, std::memory_order_relaxed);
+
+            if (auto* predecessor = tail_.exchange(node, std::memory_order_acq_rel))
+            {
+                predecessor->next.store(node, std::memory_order_release);
+                detail::SpinWait wait;
+                while (node->locked.load(std::memory_order_acquire))
+                {
+                    wait.Wait();
+                }
+            }
+
+            holder_ = node;
+        }
+
+        void unlock()
+        {
+            auto* node = holder_;
+            auto* successor = node->next.load(std::memory_order_acquire);
+            if (!successor)
+            {
+                auto* expected = node;
+                if (tail_.compare_exchange_strong(expected, nullptr, std::memory_order_acq_rel))
+                {
+                    detail::NodePool<Node>::Give(node);
+                    return;
+                }
+
+                // A new waiter has swapped the tail but not linked itself yet.
+                detail::SpinWait wait;
+                while (!(successor = node->next.load(std::memory_order_acquire)))
+                {
+                    wait.Wait();
+                }
+            }
+
+            successor->locked.store(false, std::memory_order_release);
+            detail::NodePool<Node>::Give(node);
+        }
+
+    private:
+        alignas(alignment::hardware_destructive_interference_size) std::atomic<Node*> tail_{nullptr};
+        // Written only by the current holder.
+        Node* holder_ = nullptr;
+    };
+
+    // Craig-Landin-Hagersten queue lock: every waiter spins on the node of its predecessor and takes that node
+    // over for its next acquisition. Needs no CAS and no successor link.
+    class CLHLock
+    {
+        struct alignas(alignment::hardware_destructive_interference_size) Node
+        {
+            std::atomic<bool> locked{false};
+        };
+
+    public:
+        CLHLock()
+            : tail_(new Node)
+        {
+        }
+
+        CLHLock(const CLHLock&) = delete;
+        CLHLock& operator=(const CLHLock&) = delete;
+
+        ~CLHLock()
+        {
+            delete tail_.load(std::memory_order_relaxed);
+        }
+
+        void lock()
+        {
+            auto* node = detail::NodePool<Node>::Take();
+            node->locked.store(true, std::memory_order_relaxed);
+
+            auto* predecessor = tail_.exchange(node, std::memory_order_acq_rel);
+            detail::SpinWait wait;
+            while (predecessor->locked.load(std::memory_order_acquire))
+            {
+                wait.Wait();
+            }
+
+            holder_ = node;
+            predecessor_ = predecessor;
+        }
+
+        void unlock()
+        {
+            auto* predecessor = predecessor_;
+            holder_->locked.store(false, std::memory_order_release);
+            // Nobody looks at the predecessor's node any more; our own now belongs to our successor or the lock.
+            detail::NodePool<Node>::Give(predecessor);
+        }
+
+    private:
+        alignas(alignment::hardware_destructive_interference_size) std::atomic<Node*> tail_;
+        // Written only by the current holder.
+        Node* holder_ = nullptr;
+        Node* predecessor_ = nullptr;
+    };
+
+    // Spins for a while like TTASLock and then sleeps on a futex (std::atomic::wait). The state word follows
+    // Drepper's "futexes are tricky" mutex: 0 free, 1 locked, 2 locked with sleepers.
+    class HybridLock
+    {
+        static constexpr uint32_t kSpins = 128;
+
+        enum State : uint32_t
+        {
+            Free = 0,
+            Locked = 1,
+            Contended = 2,
+        };
+
+    public:
+        void lock()
+        {
+            for (uint32_t i = 0; i < kSpins; ++i)
+            {
+                auto expected = static_cast<uint32_t>(Free);
+                if (state_.load(std::memory_order_relaxed) == Free && state_.compare_exchange_weak(expected, Locked, std::memory_order_acquire, std::memory_order_relaxed))
+                {
+                    return;
+                }
+                cpu::Relax();
+            }
+
+            while (state_.exchange(Contended, std::memory_order_acquire) != Free)
+            {
+                state_.wait(Contended, std::memory_order_relaxed);
+            }
+        }
+
+        bool try_lock()
+        {
+            auto expected = static_cast<uint32_t>(Free);
+            return state_.compare_exchange_strong(expected, Locked, std::memory_order_acquire, std::memory_order_relaxed);
+        }
+
+        void unlock()
+        {
+            if (state_.exchange(Free, std::memory_order_release) == Contended)
+            {
+                state_.notify_one();
+            }
+        }
+
+    private:
+        std::atomic<uint32_t> state_{Free};
+    };
+}
@@ -0,0 +1,279 @@
+#pragma once
+
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <optional>
+#include <utility>
+
+#include <Executor.h>
+#include <MPMCRingBuffer.h>
+#include <SPSCRingBuffer.h>
+
+namespace coro
+{
+    namespace detail
+    {
+        struct Waiter
+        {
+            // Runs on whichever thread took the waiter off its list; the coroutine is still suspended.
+            virtual bool TryComplete() = 0;
+
+            std::coroutine_handle<> handle;
+            IExecutor* executor = nullptr;
+            Waiter* next = nullptr;
+
+        protected:
+            ~Waiter() = default;
+        };
+
+        // Treiber stack that is only ever emptied as a whole, so nodes living in coroutine frames are ABA-free.
+        class WaiterList
+        {
+        public:
+            void Push(Waiter* waiter)
+            {
+                auto* head = head_.load(std::memory_order_relaxed);
+                do
+                {
+                    waiter->next = head;
+                }
+                while (!head_.compare_exchange_weak(head, waiter, std::memory_order_release, std::memory_order_relaxed));
+            }
+
+            // Returns the waiters in registration order.
+            Waiter* TakeAll()
+            {
+                auto* waiter = head_.exchange(nullptr, std::memory_order_acquire);
+                Waiter* reversed = nullptr;
+                while (waiter)
+                {
+                    reversed = std::exchange(waiter, std::exchange(waiter->next, reversed));
+                }
+
+                return reversed;
+            }
+
+            bool Empty() const
+            {
+                return head_.load(std::memory_order_relaxed) == nullptr;
+            }
+
+        private:
+            std::atomic<Waiter*> head_{nullptr};
+        };
+    }
+
+    // Awaitable adapter over a bounded lock-free buffer. Push()/Pop() complete immediately when possible;
+    // otherwise the coroutine parks on a lock-free waiter list and whoever changes the buffer next finishes
+    // the operation on its behalf and schedules it back on the executor stored in its promise.
+    //
+    // Buffer must provide bool Push(T&&) that leaves the value untouched on failure, std::optional<T> Pop(),
+    // Empty() and Full().
+    template <class T, class Buffer>
+    class Channel
+    {
+    public:
+        class PushAwaiter : private detail::Waiter
+        {
+        public:
+            bool await_ready()
+            {
+                if (!channel_.buffer_.Push(std::move(value_)))
+                {
+                    return false;
+                }
+
+                channel_.WakeAfterPush();
+                return true;
+            }
+
+            template <class Promise>
+            bool await_suspend(std::coroutine_handle<Promise> handle)
+            {
+                this->handle = handle;
+                this->executor = handle.promise().executor;
+
+                // The coroutine may be resumed on another thread as soon as it is registered, so don't touch `this` afterwards.
+                auto& channel = channel_;
+                channel.pushers_.Push(this);
+                channel.WakeAfterPop();
+                return true;
+            }
+
+            void await_resume()
+            {
+            }
+
+        private:
+            friend class Channel;
+
+            PushAwaiter(Channel& channel, T value)
+                : channel_(channel)
+                , value_(std::move(value))
+            {
+            }
+
+            bool TryComplete() override
+            {
+                return channel_.buffer_.Push(std::move(value_));
+            }
+
+        private:
+            Channel& channel_;
+            T value_;
+        };
+
+        class PopAwaiter : private detail::Waiter
+        {
+        public:
+            bool await_ready()
+            {
+                result_ = channel_.buffer_.Pop();
+                if (!result_)
+                {
+                    return false;
+                }
+
+                channel_.WakeAfterPop();
+                return true;
+            }
+
+            template <class Promise>
+            bool await_suspend(std::coroutine_handle<Promise> handle)
+            {
+                this->handle = handle;
+                this->executor = handle.promise().executor;
+
+                auto& channel = channel_;
+                channel.poppers_.Push(this);
+                channel.WakeAfterPush();
+                return true;
+            }
+
+            T await_resume()
+            {
+                return std::move(*result_);
+            }
+
+        private:
+            friend class Channel;
+
+            explicit PopAwaiter(Channel& channel)
+                : channel_(channel)
+            {
+            }
+
+            bool TryComplete() override
+            {
+                result_ = channel_.buffer_.Pop();
+                return result_.has_value();
+            }
+
+        private:
+            Channel& channel_;
+            std::optional<T> result_;
+        };
+
+        [[nodiscard]] PushAwaiter Push(T value)
+        {
+            return PushAwaiter(*this, std::move(value));
+        }
+
+        [[nodiscard]] PopAwaiter Pop()
+        {
+            return PopAwaiter(*this);
+        }
+
+        bool TryPush(T value)
+        {
+            if (!buffer_.Push(std::move(value)))
+            {
+                return false;
+            }
+
+            WakeAfterPush();
+            return true;
+        }
+
+        std::optional<T> TryPop()
+        {
+            auto result = buffer_.Pop();
+            if (result)
+            {
+                WakeAfterPop();
+            }
+
+            return result;
+        }
+
+    private:
+        bool HasData() const
+        {
+            return !buffer_.Empty();
+        }
+
+        bool HasSpace() const
+        {
+            return !buffer_.Full();
+        }
+
+        // A completed Pop may unblock pushers whose completion may unblock poppers, and so on.
+        void WakeAfterPush()
+        {
+            while (Drain(poppers_, &Channel::HasData) && Drain(pushers_, &Channel::HasSpace))
+            {
+            }
+        }
+
+        void WakeAfterPop()
+        {
+            while (Drain(pushers_, &Channel::HasSpace) && Drain(poppers_, &Channel::HasData))
+            {
+            }
+        }
+
+        // Returns true if at least one waiter completed. Registration is a store to the list followed by a check
+        // of the buffer, and a buffer change is followed by a check of the list; the seq_cst fences make sure at
+        // least one side sees the other, so a waiter is never left behind on a ready buffer.
+        bool Drain(detail::WaiterList& list, bool (Channel::*isReady)() const)
+        {
+            bool completed = false;
+            while (true)
+            {
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (list.Empty() || !(this->*isReady)())
+                {
+                    return completed;
+                }
+
+                auto* waiter = list.TakeAll();
+                while (waiter)
+                {
+                    auto* next = waiter->next;
+                    if (waiter->TryComplete())
+                    {
+                        completed = true;
+                        waiter->executor->Schedule(waiter->handle);
+                    }
+                    else
+                    {
+                        list.Push(waiter);
+                    }
+                    waiter = next;
+                }
+            }
+        }
+
+    private:
+        Buffer buffer_;
+        alignas(alignment::hardware_destructive_interference_size) detail::WaiterList pushers_;
+        alignas(alignment::hardware_destructive_interference_size) detail::WaiterList poppers_;
+    };
+
+    template <class T, std::size_t Capacity>
+    using SPSCChannel = Channel<T, lockfree::SPSCRingBuffer<T, Capacity>>;
+
+    template <class T, std::size_t Capacity>
+    using MPMCChannel = Channel<T, lockfree::MPMCRingBuffer<T, Capacity>>;
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <coroutine>
+
+namespace coro
+{
+    class IExecutor
+    {
+    public:
+        virtual ~IExecutor() = default;
+
+        // May be called from any thread.
+        virtual void Schedule(std::coroutine_handle<> handle) = 0;
+    };
+}
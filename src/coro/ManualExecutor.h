@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <mutex>
+
+#include <Executor.h>
+
+namespace coro
+{
+    // Single-threaded executor: coroutines run only inside RunOne()/RunAll() on the calling thread.
+    class ManualExecutor : public IExecutor
+    {
+    public:
+        void Schedule(std::coroutine_handle<> handle) override
+        {
+            std::lock_guard guard(mutex_);
+            queue_.push_back(handle);
+        }
+
+        bool RunOne()
+        {
+            std::coroutine_handle<> handle;
+            {
+                std::lock_guard guard(mutex_);
+                if (queue_.empty())
+                {
+                    return false;
+                }
+
+                handle = queue_.front();
+                queue_.pop_front();
+            }
+
+            handle.resume();
+            return true;
+        }
+
+        std::size_t RunAll()
+        {
+            std::size_t resumed = 0;
+            while (RunOne())
+            {
+                ++resumed;
+            }
+
+            return resumed;
+        }
+
+    private:
+        std::mutex mutex_;
+        std::deque<std::coroutine_handle<>> queue_;
+    };
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <coroutine>
+#include <exception>
+#include <utility>
+
+#include <Executor.h>
+
+namespace coro
+{
+    // Fire-and-forget coroutine. It starts only when spawned on an executor and frees its frame on completion.
+    class Task
+    {
+    public:
+        struct promise_type
+        {
+            Task get_return_object()
+            {
+                return Task{std::coroutine_handle<promise_type>::from_promise(*this)};
+            }
+
+            std::suspend_always initial_suspend() noexcept
+            {
+                return {};
+            }
+
+            std::suspend_never final_suspend() noexcept
+            {
+                return {};
+            }
+
+            void return_void()
+            {
+            }
+
+            void unhandled_exception()
+            {
+                std::terminate();
+            }
+
+            // Awaiters reschedule the coroutine here when it has to wait.
+            IExecutor* executor = nullptr;
+        };
+
+        Task(Task&& other) noexcept
+            : handle_(std::exchange(other.handle_, nullptr))
+        {
+        }
+
+        Task& operator=(Task&&) = delete;
+
+        ~Task()
+        {
+            if (handle_)
+            {
+                handle_.destroy();
+            }
+        }
+
+        friend void Spawn(IExecutor& executor, Task task)
+        {
+            auto handle = std::exchange(task.handle_, nullptr);
+            handle.promise().executor = &executor;
+            executor.Schedule(handle);
+        }
+
+    private:
+        explicit Task(std::coroutine_handle<promise_type> handle)
+            : handle_(handle)
+        {
+        }
+
+    private:
+        std::coroutine_handle<promise_type> handle_;
+    };
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+#include <Executor.h>
+
+namespace coro
+{
+    // Workers are stopped and joined on destruction; coroutines that are still queued are never resumed.
+    class ThreadPool : public IExecutor
+    {
+    public:
+        explicit ThreadPool(std::size_t threadsAmount = std::thread::hardware_concurrency())
+        {
+            workers_.reserve(threadsAmount);
+            for (std::size_t i = 0; i < threadsAmount; ++i)
+            {
+                workers_.emplace_back([this](std::stop_token token) { Work(token); });
+            }
+        }
+
+        void Schedule(std::coroutine_handle<> handle) override
+        {
+            {
+                std::lock_guard guard(mutex_);
+                queue_.push_back(handle);
+            }
+            condition_.notify_one();
+        }
+
+    private:
+        void Work(std::stop_token token)
+        {
+            while (true)
+            {
+                std::coroutine_handle<> handle;
+                {
+                    std::unique_lock lock(mutex_);
+                    if (!condition_.wait(lock, token, [this] { return !queue_.empty(); }))
+                    {
+                        return;
+                    }
+
+                    handle = queue_.front();
+                    queue_.pop_front();
+                }
+
+                handle.resume();
+            }
+        }
+
+    private:
+        std::mutex mutex_;
+        std::condition_variable_any condition_;
+        std::deque<std::coroutine_handle<>> queue_;
+        std::vector<std::jthread> workers_;
+    };
+}
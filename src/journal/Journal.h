@@ -0,0 +1,492 @@
+#pragma once
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <Alignment.h>
+#include <Debug.h>
+
+namespace journal
+{
+    // How appended records are made durable before the consumer, and a restarted process, can see them.
+    enum class Sync
+    {
+        // Records are committed right away and survive a process crash through the page cache, but not a
+        // power loss.
+        None,
+        // Every syncEvery records the written range is msync()ed, then the header.
+        Msync,
+        // Same, with fdatasync() on the files instead.
+        Fdatasync,
+    };
+
+    struct Options
+    {
+        std::filesystem::path directory;
+        // Size of each segment file, a multiple of the page size. A record may not be larger.
+        std::size_t segmentSize = 64 * 1024 * 1024;
+        Sync sync = Sync::None;
+        std::size_t syncEvery = 64;
+    };
+
+    namespace detail
+    {
+        inline constexpr uint64_t kMagic = 0x314C4E524A434350;
+        inline constexpr std::size_t kPageSize = 4096;
+        inline constexpr std::size_t kRecordAlignment = 8;
+        // A record header with this size tells the consumer to go on at the next segment.
+        inline constexpr uint32_t kPadding = UINT32_MAX;
+
+        struct RecordHeader
+        {
+            uint32_t size;
+            uint32_t reserved;
+        };
+
+        static_assert(sizeof(RecordHeader) == kRecordAlignment);
+
+        // Layout of the header page. The cursors are byte offsets into the endless sequence of segments and
+        // are only accessed through std::atomic_ref.
+        struct Header
+        {
+            uint64_t magic;
+            uint64_t segmentSize;
+            alignas(alignment::hardware_destructive_interference_size) uint64_t committed;
+            alignas(alignment::hardware_destructive_interference_size) uint64_t consumed;
+        };
+
+        static_assert(sizeof(Header) <= kPageSize);
+
+        constexpr std::size_t AlignedRecordSize(std::size_t size)
+        {
+            return (sizeof(RecordHeader) + size + kRecordAlignment - 1) & ~(kRecordAlignment - 1);
+        }
+
+        enum class Open
+        {
+            Create,
+            // The file must already be there with at least the mapped size; anything else means the journal
+            // lost a file it still needs.
+            Existing,
+        };
+
+        // Makes the creation and removal of the files in `directory` durable.
+        inline void SyncDirectory(const std::filesystem::path& directory)
+        {
+            const int fd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+            if (fd < 0)
+            {
+                throw std::system_error(errno, std::generic_category(), "Cannot open " + directory.string());
+            }
+
+            const int result = ::fsync(fd);
+            const int error = errno;
+            ::close(fd);
+            if (result != 0)
+            {
+                throw std::system_error(error, std::generic_category(), "fsync failed on " + directory.string());
+            }
+        }
+
+        // A whole file mapped read-write and shared, so the producer's and the consumer's mappings of one
+        // segment see the same pages.
+        class MappedFile
+        {
+        public:
+            MappedFile() = default;
+
+            MappedFile(const std::filesystem::path& path, std::size_t size, Open mode = Open::Create)
+                : fd_(::open(path.c_str(), O_RDWR | O_CLOEXEC | (mode == Open::Create ? O_CREAT : 0), 0644))
+                , size_(size)
+            {
+                if (fd_ < 0 && errno == ENOENT && mode == Open::Existing)
+                {
+                    throw std::runtime_error("Journal is corrupt, missing " + path.string());
+                }
+
+                if (fd_ < 0)
+                {
+                    throw std::system_error(errno, std::generic_category(), "Cannot open " + path.string());
+                }
+
+                if (mode == Open::Existing)
+                {
+                    struct stat status;
+                    if (::fstat(fd_, &status) != 0 || static_cast<std::size_t>(status.st_size) < size_)
+                    {
+                        ::close(fd_);
+                        throw std::runtime_error("Journal is corrupt, truncated " + path.string());
+                    }
+                }
+                // Reserve the blocks up front, a write to a hole on a full disk would be a SIGBUS instead.
+                else if (const auto error = ::posix_fallocate(fd_, 0, static_cast<off_t>(size_)))
+                {
+                    ::close(fd_);
+                    throw std::system_error(error, std::generic_category(), "Cannot allocate " + path.string());
+                }
+
+                auto* data = ::mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+                if (data == MAP_FAILED)
+                {
+                    ::close(fd_);
+                    throw std::system_error(errno, std::generic_category(), "Cannot map " + path.string());
+                }
+                data_ = static_cast<std::byte*>(data);
+            }
+
+            MappedFile(MappedFile&& other) noexcept
+                : fd_(std::exchange(other.fd_, -1))
+                , size_(std::exchange(other.size_, 0))
+                , data_(std::exchange(other.data_, nullptr))
+            {
+            }
+
+            MappedFile& operator=(MappedFile&& other) noexcept
+            {
+                std::swap(fd_, other.fd_);
+                std::swap(size_, other.size_);
+                std::swap(data_, other.data_);
+                return *this;
+            }
+
+            ~MappedFile()
+            {
+                if (data_)
+                {
+                    ::munmap(data_, size_);
+                    ::close(fd_);
+                }
+            }
+
+            std::byte* Data() const
+            {
+                return data_;
+            }
+
+            // Writes [offset, offset + length) back to the disk.
+            void Flush(Sync sync, std::size_t offset, std::size_t length) const
+            {
+                if (sync == Sync::Msync)
+                {
+                    const auto begin = offset & ~(kPageSize - 1);
+                    if (::msync(data_ + begin, offset + length - begin, MS_SYNC) != 0)
+                    {
+                        throw std::system_error(errno, std::generic_category(), "msync failed");
+                    }
+                }
+                else if (sync == Sync::Fdatasync && ::fdatasync(fd_) != 0)
+                {
+                    throw std::system_error(errno, std::generic_category(), "fdatasync failed");
+                }
+            }
+
+        private:
+            int fd_ = -1;
+            std::size_t size_ = 0;
+            std::byte* data_ = nullptr;
+        };
+    }
+
+    // Durable SPSC queue of byte records: a header page with the producer's and the consumer's cursors and
+    // append-only segment files, all memory-mapped. The consumer only sees committed records, so whatever it
+    // reads is also what a restarted process finds. Reads point straight into the mapping, and a consumed
+    // segment is deleted once the consumer moves past it.
+    //
+    // After a restart the producer continues at the last commit and the consumer at its last Consume(), so a
+    // record is delivered at least once; with Sync::None the consumer cursor is exact unless the machine
+    // itself goes down. Before a consumed segment is deleted the consumer cursor is flushed past it, whatever
+    // the Sync mode, so a restart never looks for a deleted segment. One thread may append and one thread may
+    // consume at a time.
+    class Journal
+    {
+    public:
+        explicit Journal(Options options)
+            : options_(std::move(options))
+        {
+            if (options_.segmentSize == 0 || options_.segmentSize % detail::kPageSize != 0)
+            {
+                throw std::invalid_argument("Segment size must be a multiple of the page size!");
+            }
+
+            std::filesystem::create_directories(options_.directory);
+            header_file_ = detail::MappedFile(options_.directory / "header", detail::kPageSize);
+            header_ = reinterpret_cast<detail::Header*>(header_file_.Data());
+            if (header_->magic == 0)
+            {
+                header_->segmentSize = options_.segmentSize;
+                header_->magic = detail::kMagic;
+                if (options_.sync != Sync::None)
+                {
+                    detail::SyncDirectory(options_.directory);
+                }
+            }
+            else if (header_->magic != detail::kMagic)
+            {
+                throw std::runtime_error("Not a journal: " + options_.directory.string());
+            }
+            else if (header_->segmentSize != options_.segmentSize)
+            {
+                throw std::runtime_error("Journal was created with segment size " + std::to_string(header_->segmentSize));
+            }
+
+            tail_ = flushed_ = Committed().load(std::memory_order_acquire);
+            head_ = Consumed().load(std::memory_order_acquire);
+            RemoveSegmentsBefore(head_ / options_.segmentSize);
+        }
+
+        Journal(const Journal&) = delete;
+        Journal& operator=(const Journal&) = delete;
+
+        ~Journal()
+        {
+            Sync();
+        }
+
+        // Producer side. Throws std::length_error when the record cannot fit into a segment.
+        void Append(std::span<const std::byte> record)
+        {
+            [[maybe_unused]] const auto guard = producer_.Enter();
+            const auto size = detail::AlignedRecordSize(record.size());
+            if (size > options_.segmentSize)
+            {
+                throw std::length_error("Record is larger than a segment!");
+            }
+
+            const auto offset = tail_ % options_.segmentSize;
+            if (offset != 0 && options_.segmentSize - offset < size)
+            {
+                const detail::RecordHeader padding{.size = detail::kPadding, .reserved = 0};
+                std::memcpy(ProducerSegment() + offset, &padding, sizeof(padding));
+                tail_ += options_.segmentSize - offset;
+            }
+
+            auto* data = ProducerSegment() + tail_ % options_.segmentSize;
+            const detail::RecordHeader header{.size = static_cast<uint32_t>(record.size()), .reserved = 0};
+            std::memcpy(data, &header, sizeof(header));
+            std::memcpy(data + sizeof(header), record.data(), record.size());
+            tail_ += size;
+
+            if (options_.sync == Sync::None)
+            {
+                Committed().store(tail_, std::memory_order_release);
+            }
+            else if (++unsynced_ >= options_.syncEvery)
+            {
+                Commit();
+            }
+        }
+
+        template <class T>
+        requires std::is_trivially_copyable_v<T> && (!std::is_convertible_v<const T&, std::span<const std::byte>>)
+        void Append(const T& value)
+        {
+            Append(std::as_bytes(std::span(&value, 1)));
+        }
+
+        // Makes every appended record durable and visible to the consumer.
+        void Sync()
+        {
+            [[maybe_unused]] const auto guard = producer_.Enter();
+            Commit();
+        }
+
+        // Consumer side. The next committed record, valid until the next Consume() or Replay().
+        std::optional<std::span<const std::byte>> Peek()
+        {
+            [[maybe_unused]] const auto guard = consumer_.Enter();
+            return Next(Committed().load(std::memory_order_acquire));
+        }
+
+        // Drops the record returned by the last Peek().
+        void Consume()
+        {
+            [[maybe_unused]] const auto guard = consumer_.Enter();
+            head_ += detail::AlignedRecordSize(ReadHeader(head_).size);
+            Consumed().store(head_, std::memory_order_release);
+        }
+
+        // Calls fn with every committed record and consumes them. The cursor is stored at the end and whenever
+        // a segment is left behind, so after a crash part-way only the current segment is replayed again.
+        // Returns how many records there were.
+        template <class Fn>
+        std::size_t Replay(Fn&& fn)
+        {
+            [[maybe_unused]] const auto guard = consumer_.Enter();
+            const auto committed = Committed().load(std::memory_order_acquire);
+
+            std::size_t replayed = 0;
+            while (const auto record = Next(committed))
+            {
+                fn(*record);
+                head_ += detail::AlignedRecordSize(record->size());
+                ++replayed;
+            }
+
+            Consumed().store(head_, std::memory_order_release);
+            return replayed;
+        }
+
+    private:
+        std::atomic_ref<uint64_t> Committed() const
+        {
+            return std::atomic_ref<uint64_t>(header_->committed);
+        }
+
+        std::atomic_ref<uint64_t> Consumed() const
+        {
+            return std::atomic_ref<uint64_t>(header_->consumed);
+        }
+
+        std::filesystem::path SegmentPath(uint64_t segment) const
+        {
+            return options_.directory / ("segment-" + std::to_string(segment));
+        }
+
+        std::byte* ProducerSegment()
+        {
+            const auto segment = tail_ / options_.segmentSize;
+            if (!producer_segment_.Data() || segment != producer_index_)
+            {
+                // Whatever is left unflushed in the old segment has to reach the disk before we let go of it.
+                if (producer_segment_.Data() && options_.sync != Sync::None && flushed_ < producer_index_ * options_.segmentSize + options_.segmentSize)
+                {
+                    const auto begin = flushed_ % options_.segmentSize;
+                    producer_segment_.Flush(options_.sync, begin, options_.segmentSize - begin);
+                    flushed_ = segment * options_.segmentSize;
+                }
+
+                producer_segment_ = detail::MappedFile(SegmentPath(segment), options_.segmentSize);
+                producer_index_ = segment;
+                if (options_.sync != Sync::None)
+                {
+                    detail::SyncDirectory(options_.directory);
+                }
+            }
+            return producer_segment_.Data();
+        }
+
+        void Commit()
+        {
+            if (options_.sync != Sync::None && flushed_ != tail_)
+            {
+                const auto begin = flushed_ % options_.segmentSize;
+                const auto end = tail_ - (tail_ - 1) / options_.segmentSize * options_.segmentSize;
+                producer_segment_.Flush(options_.sync, begin, end - begin);
+            }
+
+            flushed_ = tail_;
+            unsynced_ = 0;
+            Committed().store(tail_, std::memory_order_release);
+            if (options_.sync != Sync::None)
+            {
+                header_file_.Flush(options_.sync, 0, detail::kPageSize);
+            }
+        }
+
+        detail::RecordHeader ReadHeader(uint64_t position)
+        {
+            detail::RecordHeader header;
+            std::memcpy(&header, ConsumerSegment(position) + position % options_.segmentSize, sizeof(header));
+            return header;
+        }
+
+        std::optional<std::span<const std::byte>> Next(uint64_t committed)
+        {
+            while (head_ < committed)
+            {
+                const auto header = ReadHeader(head_);
+                if (header.size == detail::kPadding)
+                {
+                    head_ += options_.segmentSize - head_ % options_.segmentSize;
+                    continue;
+                }
+
+                const auto* data = ConsumerSegment(head_) + head_ % options_.segmentSize + sizeof(header);
+                return std::span<const std::byte>(data, header.size);
+            }
+
+            return std::nullopt;
+        }
+
+        std::byte* ConsumerSegment(uint64_t position)
+        {
+            const auto segment = position / options_.segmentSize;
+            if (!consumer_segment_.Data() || segment != consumer_index_)
+            {
+                // The producer created the segment before committing anything in it.
+                consumer_segment_ = detail::MappedFile(SegmentPath(segment), options_.segmentSize, detail::Open::Existing);
+                consumer_index_ = segment;
+
+                // Everything before this segment has been handed out already.
+                const auto start = segment * options_.segmentSize;
+                if (Consumed().load(std::memory_order_relaxed) < start)
+                {
+                    Consumed().store(start, std::memory_order_release);
+                }
+                RemoveSegmentsBefore(segment);
+            }
+            return consumer_segment_.Data();
+        }
+
+        // The consumer cursor reaches the disk before the segments it no longer points into are unlinked, and
+        // the unlinks are made durable right after.
+        void RemoveSegmentsBefore(uint64_t segment)
+        {
+            std::vector<std::filesystem::path> consumed;
+            for (const auto& entry : std::filesystem::directory_iterator(options_.directory))
+            {
+                const auto name = entry.path().filename().string();
+                if (name.starts_with("segment-") && std::stoull(name.substr(8)) < segment)
+                {
+                    consumed.push_back(entry.path());
+                }
+            }
+
+            if (consumed.empty())
+            {
+                return;
+            }
+
+            header_file_.Flush(options_.sync == Sync::Fdatasync ? Sync::Fdatasync : Sync::Msync, 0, detail::kPageSize);
+            for (const auto& path : consumed)
+            {
+                std::filesystem::remove(path);
+            }
+            detail::SyncDirectory(options_.directory);
+        }
+
+    private:
+        const Options options_;
+        detail::MappedFile header_file_;
+        detail::Header* header_ = nullptr;
+
+        alignas(alignment::hardware_destructive_interference_size) uint64_t tail_ = 0;
+        uint64_t flushed_ = 0;
+        std::size_t unsynced_ = 0;
+        uint64_t producer_index_ = 0;
+        detail::MappedFile producer_segment_;
+        [[no_unique_address]] debug::ExclusiveUse producer_;
+
+        alignas(alignment::hardware_destructive_interference_size) uint64_t head_ = 0;
+        uint64_t consumer_index_ = 0;
+        detail::MappedFile consumer_segment_;
+        [[no_unique_address]] debug::ExclusiveUse consumer_;
+    };
+}
@@ -0,0 +1,191 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <Alignment.h>
+#include <Debug.h>
+#include <Math.h>
+
+namespace lockfree
+{
+    // SPSC ring buffer that publishes its indexes in batches instead of on every element. The producer makes
+    // elements visible every batch elements, when the buffer is full, or on Flush(). The consumer hands slots
+    // back every MaxBatch elements or when it runs dry.
+    // Every MaxBatch pushes, and whenever the buffer is full, the producer reads the consumer's head and adapts
+    // the batch to the lag: it doubles while the consumer is at least MaxBatch elements behind, which it only
+    // is while it never runs dry, and halves once the consumer has caught up with the current batch. At batch 1
+    // it behaves like SPSCRingBuffer, one store per push.
+    // Every kIdlePolls empty Pop() calls the consumer also reads the producer's unpublished tail, so elements of
+    // a producer that went quiet mid-batch show up without a Flush().
+    template <class T, std::size_t Capacity, std::size_t MaxBatch = 64, class Allocator = std::allocator<T>>
+    class BatchedSPSCRingBuffer
+    {
+        static_assert(math::IsPowerOf2(Capacity), "Size must be a power of 2");
+        static_assert(MaxBatch > 0 && MaxBatch <= Capacity, "Batch must fit into the buffer!");
+
+    public:
+        explicit BatchedSPSCRingBuffer(const Allocator& allocator = Allocator())
+            : data_(Capacity, allocator)
+        {
+        }
+
+        // The value is left untouched when the buffer is full.
+        bool Push(const T& data)
+        {
+            return Emplace(data);
+        }
+
+        bool Push(T&& data)
+        {
+            return Emplace(std::move(data));
+        }
+
+        static constexpr int kIdlePolls = 16;
+
+        // Makes every pushed element visible to the consumer right away, not only after its idle polls.
+        void Flush()
+        {
+            if (tail_local_ != tail_published_)
+            {
+                PublishTail();
+            }
+        }
+
+        std::optional<T> Pop()
+        {
+            [[maybe_unused]] const auto guard = consumer_.Enter();
+            const auto head = head_local_;
+            if (head == tail_cached_)
+            {
+                // Give the slots back before reporting empty, so a producer waiting for space is not stuck.
+                PublishHead();
+                // Indexes only grow. The published tail can trail what was already read through the pending one.
+                auto tail = tail_.load(std::memory_order_acquire);
+                if (tail <= head && ++idle_polls_ >= kIdlePolls)
+                {
+                    // Only now touch the producer's own cache line, and then not again for another kIdlePolls.
+                    idle_polls_ = 0;
+                    tail = tail_pending_.load(std::memory_order_acquire);
+                }
+                if (tail <= head)
+                {
+                    return std::nullopt;
+                }
+
+                idle_polls_ = 0;
+                tail_cached_ = tail;
+            }
+
+            auto data = std::move(data_[Index(head)]);
+            head_local_ = head + 1;
+            if (head_local_ - head_published_ >= MaxBatch)
+            {
+                PublishHead();
+            }
+
+            return data;
+        }
+
+        // Current producer batch, for tests and metrics. Must be called by the producer.
+        std::size_t Batch() const
+        {
+            return batch_;
+        }
+
+    private:
+        template <class U>
+        bool Emplace(U&& data)
+        {
+            [[maybe_unused]] const auto guard = producer_.Enter();
+            const auto tail = tail_local_;
+            if (tail - head_cached_ == Capacity)
+            {
+                // The consumer may be waiting for exactly the elements we have not published yet.
+                Flush();
+                Adapt(tail);
+                if (tail - head_cached_ == Capacity)
+                {
+                    return false;
+                }
+            }
+            else if (tail - adapted_at_ >= MaxBatch)
+            {
+                Adapt(tail);
+            }
+
+            data_[Index(tail)] = std::forward<U>(data);
+            tail_local_ = tail + 1;
+            // Exactly one store per push: the published tail once a batch is complete, the pending one before.
+            if (tail_local_ - tail_published_ >= batch_)
+            {
+                PublishTail();
+            }
+            else
+            {
+                tail_pending_.store(tail_local_, std::memory_order_release);
+            }
+
+            return true;
+        }
+
+        void Adapt(std::size_t tail)
+        {
+            adapted_at_ = tail;
+            head_cached_ = head_.load(std::memory_order_acquire);
+            const auto lag = tail - head_cached_;
+            if (lag >= MaxBatch)
+            {
+                batch_ = std::min(batch_ * 2, MaxBatch);
+            }
+            else if (lag < batch_)
+            {
+                batch_ = std::max<std::size_t>(batch_ / 2, 1);
+            }
+        }
+
+        void PublishTail()
+        {
+            tail_published_ = tail_local_;
+            tail_.store(tail_published_, std::memory_order_release);
+        }
+
+        void PublishHead()
+        {
+            if (head_local_ != head_published_)
+            {
+                head_.store(head_local_, std::memory_order_release);
+                head_published_ = head_local_;
+            }
+        }
+
+        static constexpr std::size_t Index(std::size_t index)
+        {
+            return index & (Capacity - 1);
+        }
+
+    private:
+        alignas(alignment::hardware_destructive_interference_size) std::atomic<std::size_t> head_{0};
+        alignas(alignment::hardware_destructive_interference_size) std::size_t head_local_{0};
+        std::size_t head_published_{0};
+        std::size_t tail_cached_{0};
+        int idle_polls_{0};
+        [[no_unique_address]] debug::ExclusiveUse consumer_;
+        alignas(alignment::hardware_destructive_interference_size) std::atomic<std::size_t> tail_{0};
+        // Written by the pushes that do not complete a batch, read by the consumer only every kIdlePolls empty
+        // polls, so it stays in the producer's cache. May trail tail_.
+        alignas(alignment::hardware_destructive_interference_size) std::atomic<std::size_t> tail_pending_{0};
+        std::size_t tail_local_{0};
+        std::size_t tail_published_{0};
+        std::size_t adapted_at_{0};
+        std::size_t head_cached_{0};
+        std::size_t batch_{1};
+        [[no_unique_address]] debug::ExclusiveUse producer_;
+        std::vector<T, Allocator> data_;
+    };
+}
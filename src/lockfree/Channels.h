@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+
+#include <MPMCRingBuffer.h>
+#include <Queue.h>
+#include <SPSCRingBuffer.h>
+#include <SPSCUnboundedQueue.h>
+#include <WaitFreeQueue.h>
+
+namespace lockfree
+{
+    enum class Producers
+    {
+        Single,
+        Multi,
+    };
+
+    enum class Consumers
+    {
+        Single,
+        Multi,
+    };
+
+    template <std::size_t Capacity>
+    struct Bounded
+    {
+    };
+
+    struct Unbounded
+    {
+    };
+
+    namespace detail
+    {
+        template <class T, Producers P, Consumers C, class Bound>
+        struct ChannelFor;
+
+        template <class T, Producers P, Consumers C, std::size_t Capacity>
+        struct ChannelFor<T, P, C, Bounded<Capacity>>
+        {
+            using Type = MPMCRingBuffer<T, Capacity>;
+        };
+
+        template <class T, std::size_t Capacity>
+        struct ChannelFor<T, Producers::Single, Consumers::Single, Bounded<Capacity>>
+        {
+            using Type = SPSCRingBuffer<T, Capacity>;
+        };
+
+        template <class T, Producers P, Consumers C>
+        struct ChannelFor<T, P, C, Unbounded>
+        {
+            using Type = WaitFreeQueue<T>;
+        };
+
+        template <class T>
+        struct ChannelFor<T, Producers::Single, Consumers::Single, Unbounded>
+        {
+            using Type = SPSCUnboundedQueue<T>;
+        };
+    }
+
+    // The cheapest queue that is still correct for the declared number of producers and consumers. There is
+    // no dedicated MPSC or SPMC queue for arbitrary T, so those fall back to the MPMC ones. The unbounded MPMC
+    // one is WaitFreeQueue, which frees popped nodes through hazard pointers (MSQueue never frees them), so
+    // at most 64 threads may use it at once. Single-threaded sides assert in debug builds when two threads
+    // use them at once.
+    template <class T, Producers P, Consumers C, class Bound>
+    using Channel = typename detail::ChannelFor<T, P, C, Bound>::Type;
+}
@@ -0,0 +1,619 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include <Alignment.h>
+#include <Packing.h>
+#include <ThreadRegistry.h>
+
+namespace lockfree
+{
+    // Open-addressing linear-probing map in the spirit of Cliff Click's NonBlockingHashMap.
+    // A key is claimed once with a CAS and never leaves its slot; the value word packs a
+    // 48-bit payload with a 16-bit state, so every value transition (insert, update, erase,
+    // freeze for migration) is a single CAS. Find() only retries when a resize finishes under it.
+    //
+    // Resizing is cooperative: the first writer that crosses the load threshold publishes a
+    // successor table and every following writer migrates one bucket chunk before doing its own
+    // work. Every operation pins the table it started from, one slot per thread, and walks only
+    // towards newer tables, so once the root has moved on the retired tables older than every
+    // pin are freed. At most MaxThreads threads may use maps with the same MaxThreads at once
+    // (see ThreadRegistry).
+    template <class K, class V, class Hash = std::hash<K>, std::size_t MaxThreads = 64>
+    class ConcurrentHashMap
+    {
+        static_assert(std::is_trivially_copyable_v<K>, "Key must be trivially copyable!");
+        static_assert(std::is_trivially_copyable_v<V>, "Value must be trivially copyable!");
+        static_assert(std::equality_comparable<K>, "Key must be equality comparable!");
+        static_assert(std::atomic<K>::is_always_lock_free, "Key must fit into a lock-free atomic!");
+        static_assert(std::is_pointer_v<V> || sizeof(V) <= sizeof(uint32_t), "Value must be a pointer or fit into 32 bits!");
+
+        enum class State : uint16_t
+        {
+            Empty = 0,
+            Live,
+            Tombstone,
+            Frozen,
+            Moved,
+        };
+
+        struct Slot
+        {
+            std::atomic<K> key;
+            std::atomic<uint64_t> value{0};
+        };
+
+        static constexpr std::size_t kSlotsPerBucket = std::max<std::size_t>(1, alignment::hardware_destructive_interference_size / sizeof(Slot));
+        static constexpr std::size_t kMigrationChunk = kSlotsPerBucket * 4;
+
+        struct alignas(alignment::hardware_destructive_interference_size) Bucket
+        {
+            std::array<Slot, kSlotsPerBucket> slots;
+        };
+
+        struct Table
+        {
+            Table(std::size_t capacity, K emptyKey)
+                : capacity(capacity)
+                , shift(64 - std::countr_zero(capacity))
+                , maxProbes(std::min(capacity, 10 + capacity / 4))
+                , buckets(new Bucket[capacity / kSlotsPerBucket])
+            {
+                for (std::size_t i = 0; i < capacity; ++i)
+                {
+                    At(i).key.store(emptyKey, std::memory_order_relaxed);
+                }
+            }
+
+            Slot& At(std::size_t index) const
+            {
+                index &= capacity - 1;
+                return buckets[index / kSlotsPerBucket].slots[index % kSlotsPerBucket];
+            }
+
+            const std::size_t capacity;
+            const int shift;
+            const std::size_t maxProbes;
+            const std::unique_ptr<Bucket[]> buckets;
+
+            alignas(alignment::hardware_destructive_interference_size) std::atomic<std::size_t> claimed{0};
+            alignas(alignment::hardware_destructive_interference_size) std::atomic<std::size_t> copyIndex{0};
+            std::atomic<std::size_t> copyDone{0};
+            std::atomic<Table*> next{nullptr};
+        };
+
+        struct alignas(alignment::hardware_destructive_interference_size) Pin
+        {
+            std::atomic<Table*> table{nullptr};
+        };
+
+        // Keeps the table the operation started from, and every newer one, alive until it ends.
+        class Pinned
+        {
+        public:
+            explicit Pinned(const ConcurrentHashMap& map)
+                : pin_(map.pins_[ThreadRegistry<MaxThreads>::Index()].table)
+            {
+                table_ = map.root_.load(std::memory_order_seq_cst);
+                while (true)
+                {
+                    pin_.store(table_, std::memory_order_seq_cst);
+                    auto* root = map.root_.load(std::memory_order_seq_cst);
+                    if (root == table_)
+                    {
+                        break;
+                    }
+                    table_ = root;
+                }
+            }
+
+            Pinned(const Pinned&) = delete;
+            Pinned& operator=(const Pinned&) = delete;
+
+            ~Pinned()
+            {
+                pin_.store(nullptr, std::memory_order_release);
+            }
+
+            Table* Get() const
+            {
+                return table_;
+            }
+
+        private:
+            std::atomic<Table*>& pin_;
+            Table* table_ = nullptr;
+        };
+
+        enum class Op
+        {
+            Insert,
+            Assign,
+            Update,
+            CompareExchange,
+            Erase,
+        };
+
+    public:
+        explicit ConcurrentHashMap(std::size_t capacity = 1024, K emptyKey = K{})
+            : emptyKey_(emptyKey)
+        {
+            capacity = std::bit_ceil(std::max(capacity, kSlotsPerBucket));
+            head_ = new Table(capacity, emptyKey_);
+            root_.store(head_, std::memory_order_relaxed);
+        }
+
+        ~ConcurrentHashMap()
+        {
+            while (head_)
+            {
+                delete std::exchange(head_, head_->next.load(std::memory_order_relaxed));
+            }
+        }
+
+        ConcurrentHashMap(const ConcurrentHashMap&) = delete;
+        ConcurrentHashMap& operator=(const ConcurrentHashMap&) = delete;
+
+        std::optional<V> Find(K key) const
+        {
+            assert(!(key == emptyKey_));
+
+            const Pinned pinned(*this);
+            const auto word = Search(pinned.Get(), key);
+            if (!word || GetState(*word) == State::Tombstone)
+            {
+                return std::nullopt;
+            }
+
+            return Decode(*word);
+        }
+
+        bool Contains(K key) const
+        {
+            return Find(key).has_value();
+        }
+
+        // Inserts the value only if the key is absent.
+        bool Insert(K key, V value)
+        {
+            return Put(key, Op::Insert, value, value);
+        }
+
+        // Returns true if the key was absent before the call.
+        bool InsertOrAssign(K key, V value)
+        {
+            return Put(key, Op::Assign, value, value);
+        }
+
+        // Replaces the value only if the key is present.
+        bool Update(K key, V value)
+        {
+            return Put(key, Op::Update, value, value);
+        }
+
+        bool CompareExchange(K key, V expected, V desired)
+        {
+            return Put(key, Op::CompareExchange, desired, expected);
+        }
+
+        bool Erase(K key)
+        {
+            return Put(key, Op::Erase, V{}, V{});
+        }
+
+        // Approximate while writers are running: an Erase may be counted before the Insert it removed.
+        std::size_t Size() const
+        {
+            return static_cast<std::size_t>(std::max<std::ptrdiff_t>(size_.load(std::memory_order_relaxed), 0));
+        }
+
+        std::size_t Capacity() const
+        {
+            const Pinned pinned(*this);
+            return pinned.Get()->capacity;
+        }
+
+        // Tables still allocated, the current one included. Stays small unless a reader is stuck in an old one.
+        std::size_t Tables() const
+        {
+            return tables_.load(std::memory_order_relaxed);
+        }
+
+    private:
+        static uint64_t Encode(State state, V value)
+        {
+            uint64_t payload = 0;
+            std::memcpy(&payload, &value, sizeof(V));
+            return packing::PackPayloadWithData(payload, static_cast<uint16_t>(state));
+        }
+
+        static uint64_t Restate(State state, uint64_t word)
+        {
+            return packing::PackPayloadWithData(packing::UnpackPayload(word), static_cast<uint16_t>(state));
+        }
+
+        static V Decode(uint64_t word)
+        {
+            V value;
+            const auto payload = packing::UnpackPayload(word);
+            std::memcpy(&value, &payload, sizeof(V));
+            return value;
+        }
+
+        static State GetState(uint64_t word)
+        {
+            return static_cast<State>(packing::UnpackData(word));
+        }
+
+        static std::size_t HomeIndex(const Table* table, K key)
+        {
+            // Fibonacci hashing keeps identity hashes of sequential keys from piling up in one bucket.
+            return static_cast<std::size_t>((static_cast<uint64_t>(Hash{}(key)) * 0x9E3779B97F4A7C15ull) >> table->shift);
+        }
+
+        // Returns the slot that holds the key, or nullptr if the key is absent from the table.
+        Slot* Probe(const Table* table, K key) const
+        {
+            const auto home = HomeIndex(table, key);
+            for (std::size_t i = 0; i < table->maxProbes; ++i)
+            {
+                auto& slot = table->At(home + i);
+                const K current = slot.key.load(std::memory_order_acquire);
+                if (current == key)
+                {
+                    return &slot;
+                }
+
+                if (current == emptyKey_)
+                {
+                    return nullptr;
+                }
+            }
+
+            return nullptr;
+        }
+
+        // Returns the slot that holds the key, claiming an empty one if needed, or nullptr if the probe limit is hit.
+        Slot* ProbeOrClaim(Table* table, K key)
+        {
+            const auto home = HomeIndex(table, key);
+            for (std::size_t i = 0; i < table->maxProbes; ++i)
+            {
+                auto& slot = table->At(home + i);
+                K current = slot.key.load(std::memory_order_acquire);
+                if (current == emptyKey_)
+                {
+                    if (slot.key.compare_exchange_strong(current, key, std::memory_order_acq_rel, std::memory_order_acquire))
+                    {
+                        if (table->claimed.fetch_add(1, std::memory_order_relaxed) + 1 >= table->capacity / 4 * 3)
+                        {
+                            StartResize(table, false);
+                        }
+                        return &slot;
+                    }
+                }
+
+                if (current == key)
+                {
+                    return &slot;
+                }
+            }
+
+            return nullptr;
+        }
+
+        // Returns the Live or Tombstone word that is current for the key, or nullopt if the key is absent.
+        std::optional<uint64_t> Search(const Table* table, K key) const
+        {
+            while (table)
+            {
+                const auto* slot = Probe(table, key);
+                const auto* next = table->next.load(std::memory_order_acquire);
+                if (slot)
+                {
+                    const auto word = slot->value.load(std::memory_order_acquire);
+                    switch (GetState(word))
+                    {
+                        case State::Live:
+                        case State::Tombstone:
+                            return word;
+                        case State::Frozen:
+                            // Writers only reach the successor after the frozen value was copied there.
+                            if (auto newer = Search(next, key))
+                            {
+                                return newer;
+                            }
+                            return Restate(State::Live, word);
+                        case State::Empty:
+                        case State::Moved:
+                            break;
+                    }
+                }
+
+                table = next;
+            }
+
+            return std::nullopt;
+        }
+
+        bool Put(K key, Op op, V desired, V expected)
+        {
+            assert(!(key == emptyKey_));
+
+            const bool inserts = op == Op::Insert || op == Op::Assign;
+            const Pinned pinned(*this);
+            auto* table = pinned.Get();
+            HelpResize(table);
+
+            while (true)
+            {
+                auto* slot = inserts ? ProbeOrClaim(table, key) : Probe(table, key);
+                if (!slot)
+                {
+                    auto* next = table->next.load(std::memory_order_acquire);
+                    if (inserts)
+                    {
+                        table = next ? next : StartResize(table, true);
+                        continue;
+                    }
+
+                    if (!next)
+                    {
+                        return false;
+                    }
+
+                    table = next;
+                    continue;
+                }
+
+                if (auto* next = table->next.load(std::memory_order_acquire))
+                {
+                    CopySlot(table, *slot);
+                    table = next;
+                    continue;
+                }
+
+                auto word = slot->value.load(std::memory_order_acquire);
+                while (true)
+                {
+                    const auto state = GetState(word);
+                    if (state == State::Frozen || state == State::Moved)
+                    {
+                        break;
+                    }
+
+                    const bool live = state == State::Live;
+                    uint64_t newWord = 0;
+                    switch (op)
+                    {
+                        case Op::Insert:
+                            if (live)
+                            {
+                                return false;
+                            }
+                            newWord = Encode(State::Live, desired);
+                            break;
+                        case Op::Assign:
+                            newWord = Encode(State::Live, desired);
+                            break;
+                        case Op::Update:
+                            if (!live)
+                            {
+                                return false;
+                            }
+                            newWord = Encode(State::Live, desired);
+                            break;
+                        case Op::CompareExchange:
+                            if (!live || word != Encode(State::Live, expected))
+                            {
+                                return false;
+                            }
+                            newWord = Encode(State::Live, desired);
+                            break;
+                        case Op::Erase:
+                            if (!live)
+                            {
+                                return false;
+                            }
+                            newWord = Restate(State::Tombstone, word);
+                            break;
+                    }
+
+                    if (slot->value.compare_exchange_weak(word, newWord, std::memory_order_acq_rel, std::memory_order_acquire))
+                    {
+                        if (op == Op::Erase)
+                        {
+                            size_.fetch_sub(1, std::memory_order_relaxed);
+                        }
+                        else if (!live)
+                        {
+                            size_.fetch_add(1, std::memory_order_relaxed);
+                        }
+
+                        return op != Op::Assign || !live;
+                    }
+                }
+
+                CopySlot(table, *slot);
+                table = table->next.load(std::memory_order_acquire);
+            }
+        }
+
+        // Probe limit overflows always grow; a table that is mostly tombstones is rehashed at the same size.
+        Table* StartResize(Table* table, bool probeOverflow)
+        {
+            if (auto* next = table->next.load(std::memory_order_acquire))
+            {
+                return next;
+            }
+
+            const bool grow = probeOverflow || static_cast<std::size_t>(Size()) * 2 >= table->capacity;
+            auto* candidate = new Table(grow ? table->capacity * 2 : table->capacity, emptyKey_);
+
+            Table* expected = nullptr;
+            if (!table->next.compare_exchange_strong(expected, candidate, std::memory_order_acq_rel, std::memory_order_acquire))
+            {
+                delete candidate;
+                return expected;
+            }
+
+            tables_.fetch_add(1, std::memory_order_relaxed);
+            return candidate;
+        }
+
+        void HelpResize(Table* table)
+        {
+            if (!table->next.load(std::memory_order_acquire))
+            {
+                return;
+            }
+
+            const auto begin = table->copyIndex.fetch_add(kMigrationChunk, std::memory_order_relaxed);
+            if (begin >= table->capacity)
+            {
+                return;
+            }
+
+            const auto end = std::min(begin + kMigrationChunk, table->capacity);
+            for (auto i = begin; i < end; ++i)
+            {
+                CopySlot(table, table->At(i));
+            }
+
+            if (table->copyDone.fetch_add(end - begin, std::memory_order_acq_rel) + (end - begin) == table->capacity)
+            {
+                Promote();
+            }
+        }
+
+        void Promote()
+        {
+            auto* table = root_.load(std::memory_order_acquire);
+            while (table->copyDone.load(std::memory_order_acquire) == table->capacity)
+            {
+                auto* next = table->next.load(std::memory_order_acquire);
+                if (!root_.compare_exchange_strong(table, next, std::memory_order_seq_cst, std::memory_order_acquire))
+                {
+                    break;
+                }
+
+                table = next;
+            }
+
+            Reclaim();
+        }
+
+        // Frees the retired tables in front of the oldest pinned one. Operations only walk from their pinned
+        // table towards newer ones, and a table is pinned only after it was seen as the root, so nothing can
+        // reach what is freed here. One thread reclaims at a time; the others leave it to the next Promote.
+        void Reclaim()
+        {
+            if (reclaiming_.test_and_set(std::memory_order_acquire))
+            {
+                return;
+            }
+
+            const auto* root = root_.load(std::memory_order_seq_cst);
+            std::array<const Table*, MaxThreads> pinned;
+            for (std::size_t i = 0; i < MaxThreads; ++i)
+            {
+                pinned[i] = pins_[i].table.load(std::memory_order_seq_cst);
+            }
+
+            while (head_ != root && std::find(pinned.begin(), pinned.end(), head_) == pinned.end())
+            {
+                delete std::exchange(head_, head_->next.load(std::memory_order_acquire));
+                tables_.fetch_sub(1, std::memory_order_relaxed);
+            }
+
+            reclaiming_.clear(std::memory_order_release);
+        }
+
+        // Freezes the slot, copies a live value into the successor table and marks the slot Moved.
+        void CopySlot(Table* table, Slot& slot)
+        {
+            auto word = slot.value.load(std::memory_order_acquire);
+            while (true)
+            {
+                switch (GetState(word))
+                {
+                    case State::Moved:
+                        return;
+                    case State::Empty:
+                    case State::Tombstone:
+                        if (slot.value.compare_exchange_weak(word, Restate(State::Moved, word), std::memory_order_acq_rel, std::memory_order_acquire))
+                        {
+                            return;
+                        }
+                        continue;
+                    case State::Live:
+                        if (!slot.value.compare_exchange_weak(word, Restate(State::Frozen, word), std::memory_order_acq_rel, std::memory_order_acquire))
+                        {
+                            continue;
+                        }
+                        word = Restate(State::Frozen, word);
+                        break;
+                    case State::Frozen:
+                        break;
+                }
+
+                CopyInsert(table->next.load(std::memory_order_acquire), slot.key.load(std::memory_order_acquire), word);
+                slot.value.compare_exchange_strong(word, Restate(State::Moved, word), std::memory_order_acq_rel, std::memory_order_acquire);
+                return;
+            }
+        }
+
+        // Puts a frozen value into the table only if no newer value for the key got there first.
+        void CopyInsert(Table* table, K key, uint64_t frozen)
+        {
+            while (true)
+            {
+                auto* slot = ProbeOrClaim(table, key);
+                if (!slot)
+                {
+                    table = StartResize(table, true);
+                    continue;
+                }
+
+                auto word = slot->value.load(std::memory_order_acquire);
+                while (GetState(word) == State::Empty)
+                {
+                    if (slot->value.compare_exchange_weak(word, Restate(State::Live, frozen), std::memory_order_acq_rel, std::memory_order_acquire))
+                    {
+                        return;
+                    }
+                }
+
+                if (GetState(word) != State::Moved)
+                {
+                    return;
+                }
+
+                table = table->next.load(std::memory_order_acquire);
+            }
+        }
+
+    private:
+        const K emptyKey_;
+        // Oldest table still allocated, owned by whoever holds reclaiming_.
+        Table* head_ = nullptr;
+        std::atomic_flag reclaiming_;
+        std::atomic<std::size_t> tables_{1};
+        alignas(alignment::hardware_destructive_interference_size) std::atomic<Table*> root_{nullptr};
+        alignas(alignment::hardware_destructive_interference_size) std::atomic<std::ptrdiff_t> size_{0};
+        mutable std::array<Pin, MaxThreads> pins_;
+    };
+}
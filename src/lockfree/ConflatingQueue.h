@@ -0,0 +1,120 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <Backoff.h>
+#include <MPMCRingBuffer.h>
+
+namespace lockfree
+{
+    // Keyed latest-value queue: a Push for a key that is still pending replaces the pending value instead of
+    // queueing a second one, so consumers only ever see the newest value per key and the backlog is bounded
+    // by the number of keys. Keys are dense indices in [0, Keys), e.g. instrument or sensor ids. Any number of
+    // producers and consumers; keys come out in the order they first became pending. Every key keeps the pending
+    // value plus up to two spares and cycles between them, so once a key has been warmed up Push and Pop no
+    // longer allocate.
+    template <class T, std::size_t Keys>
+    class ConflatingQueue
+    {
+        static_assert(Keys > 0, "ConflatingQueue needs at least one key!");
+
+    public:
+        ConflatingQueue() = default;
+
+        ConflatingQueue(const ConflatingQueue&) = delete;
+        ConflatingQueue& operator=(const ConflatingQueue&) = delete;
+
+        ~ConflatingQueue()
+        {
+            for (std::size_t key = 0; key < Keys; ++key)
+            {
+                delete pending_[key].load(std::memory_order_relaxed);
+            }
+            for (auto& spare : spares_)
+            {
+                delete spare.load(std::memory_order_relaxed);
+            }
+        }
+
+        // Returns false when the value replaced an older pending one.
+        bool Push(std::size_t key, T value)
+        {
+            T* fresh = nullptr;
+            for (std::size_t i = 0; i < kSpares && !fresh; ++i)
+            {
+                fresh = spares_[key * kSpares + i].exchange(nullptr, std::memory_order_acquire);
+            }
+
+            if (fresh)
+            {
+                *fresh = std::move(value);
+            }
+            else
+            {
+                fresh = new T(std::move(value));
+            }
+
+            if (auto* stale = pending_[key].exchange(fresh, std::memory_order_acq_rel))
+            {
+                Recycle(key, stale);
+                return false;
+            }
+
+            // The key just became pending and only this Push queues it, so the ready queue never holds a key
+            // twice and at most Keys entries are live. The ring has at least Keys cells, so a Push can only
+            // fail while a Pop that has already taken its key is still releasing the cell; wait for it.
+            while (!ready_.Push(key))
+            {
+                backoff::Pause().Wait();
+            }
+            return true;
+        }
+
+        std::optional<std::pair<std::size_t, T>> Pop()
+        {
+            const auto key = ready_.Pop();
+            if (!key)
+            {
+                return std::nullopt;
+            }
+
+            auto* value = pending_[*key].exchange(nullptr, std::memory_order_acq_rel);
+            auto result = std::make_pair(*key, std::move(*value));
+            Recycle(*key, value);
+            return result;
+        }
+
+        bool Empty() const
+        {
+            return ready_.Empty();
+        }
+
+    private:
+        // A Push that conflates needs a spare for the new value while the displaced one goes back, hence two.
+        static constexpr std::size_t kSpares = 2;
+
+        // Keeps the value as one of the key's spares, unless they are all taken.
+        void Recycle(std::size_t key, T* value)
+        {
+            for (std::size_t i = 0; i < kSpares; ++i)
+            {
+                T* expected = nullptr;
+                if (spares_[key * kSpares + i].compare_exchange_strong(expected, value, std::memory_order_release, std::memory_order_relaxed))
+                {
+                    return;
+                }
+            }
+            delete value;
+        }
+
+        std::vector<std::atomic<T*>> pending_ = std::vector<std::atomic<T*>>(Keys);
+        std::vector<std::atomic<T*>> spares_ = std::vector<std::atomic<T*>>(Keys * kSpares);
+        MPMCRingBuffer<std::size_t, std::bit_ceil(std::max<std::size_t>(Keys, 2))> ready_;
+    };
+}
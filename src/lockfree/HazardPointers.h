@@ -0,0 +1,104 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+#include <Alignment.h>
+
+namespace lockfree
+{
+    // Hazard pointers indexed by ThreadRegistry indexes. Protect() is a plain store and never retries, so the
+    // caller has to validate the pointer against its source afterwards; that keeps it usable in wait-free code.
+    // Retired objects wait in a per-thread list that is scanned once it holds twice as many objects as there are
+    // hazard slots (Michael's scheme), so a scan frees at least half of it and costs O(log slots) per Retire().
+    template <class T, std::size_t MaxThreads, std::size_t Hazards>
+    class HazardPointers
+    {
+        static constexpr std::size_t kScanThreshold = 2 * MaxThreads * Hazards;
+
+    public:
+        HazardPointers() = default;
+        HazardPointers(const HazardPointers&) = delete;
+        HazardPointers& operator=(const HazardPointers&) = delete;
+
+        ~HazardPointers()
+        {
+            for (auto& record : records_)
+            {
+                for (auto* object : record.retired)
+                {
+                    delete object;
+                }
+            }
+        }
+
+        T* Protect(std::size_t hazard, T* object, std::size_t thread)
+        {
+            records_[thread].hazards[hazard].store(object);
+            return object;
+        }
+
+        void Clear(std::size_t thread)
+        {
+            for (auto& hazard : records_[thread].hazards)
+            {
+                hazard.store(nullptr, std::memory_order_release);
+            }
+        }
+
+        // Deletes the object once no thread protects it, at the latest when the thread's list is next scanned.
+        void Retire(T* object, std::size_t thread)
+        {
+            auto& record = records_[thread];
+            record.retired.push_back(object);
+            if (record.retired.size() >= kScanThreshold)
+            {
+                Scan(record);
+            }
+        }
+
+    private:
+        struct alignas(alignment::hardware_destructive_interference_size) Record
+        {
+            std::array<std::atomic<T*>, Hazards> hazards{};
+            std::vector<T*> retired;
+            // Snapshot of every hazard slot, kept to scan without allocating.
+            std::vector<T*> protectedObjects;
+        };
+
+        void Scan(Record& scanner)
+        {
+            auto& snapshot = scanner.protectedObjects;
+            snapshot.clear();
+            for (const auto& record : records_)
+            {
+                for (const auto& hazard : record.hazards)
+                {
+                    if (auto* object = hazard.load())
+                    {
+                        snapshot.push_back(object);
+                    }
+                }
+            }
+            std::sort(snapshot.begin(), snapshot.end(), std::less<T*>());
+
+            const auto end = std::remove_if(scanner.retired.begin(), scanner.retired.end(), [&snapshot](T* candidate)
+            {
+                if (std::binary_search(snapshot.begin(), snapshot.end(), candidate, std::less<T*>()))
+                {
+                    return false;
+                }
+
+                delete candidate;
+                return true;
+            });
+            scanner.retired.erase(end, scanner.retired.end());
+        }
+
+        std::array<Record, MaxThreads> records_;
+    };
+}
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+#include <Alignment.h>
+#include <Debug.h>
+
+namespace lockfree
+{
+    // Elements of an IntrusiveMPSCQueue derive from this hook. An element can sit in one queue at a time
+    // and must stay alive until it is popped. Copying an element does not copy its link.
+    class MPSCQueueHook
+    {
+    public:
+        MPSCQueueHook() = default;
+
+        MPSCQueueHook(const MPSCQueueHook&)
+        {
+        }
+
+        MPSCQueueHook& operator=(const MPSCQueueHook&)
+        {
+            return *this;
+        }
+
+    private:
+        template <class>
+        friend class IntrusiveMPSCQueue;
+
+        std::atomic<MPSCQueueHook*> next_{nullptr};
+    };
+
+    // Vyukov's intrusive MPSC queue. Push is a single exchange, Pop and PopAll may only be called by one
+    // consumer and never loop. Pop can miss an element whose producer has done the exchange but not yet
+    // linked it; that element shows up on a later Pop. The queue never allocates or frees elements.
+    template <class T>
+    class IntrusiveMPSCQueue
+    {
+        static_assert(std::is_base_of_v<MPSCQueueHook, T>, "T must derive from MPSCQueueHook!");
+
+    public:
+        IntrusiveMPSCQueue()
+            : head_(&stub_)
+            , tail_(&stub_)
+        {
+        }
+
+        IntrusiveMPSCQueue(const IntrusiveMPSCQueue&) = delete;
+        IntrusiveMPSCQueue& operator=(const IntrusiveMPSCQueue&) = delete;
+
+        void Push(T* element)
+        {
+            Link(element);
+        }
+
+        T* Pop()
+        {
+            [[maybe_unused]] const auto guard = consumer_.Enter();
+            auto* tail = tail_;
+            auto* next = tail->next_.load(std::memory_order_acquire);
+            if (tail == &stub_)
+            {
+                if (!next)
+                {
+                    return nullptr;
+                }
+
+                tail_ = tail = next;
+                next = next->next_.load(std::memory_order_acquire);
+            }
+
+            if (next)
+            {
+                tail_ = next;
+                return static_cast<T*>(tail);
+            }
+
+            if (tail != head_.load(std::memory_order_acquire))
+            {
+                // A producer has swapped the head but not linked its element yet.
+                return nullptr;
+            }
+
+            // The tail is the last element: put the stub behind it so that it can be unlinked.
+            Link(&stub_);
+            next = tail->next_.load(std::memory_order_acquire);
+            if (next)
+            {
+                tail_ = next;
+                return static_cast<T*>(tail);
+            }
+
+            return nullptr;
+        }
+
+        // Pops every element pushed before the call, oldest first, and returns how many there were.
+        // Elements pushed concurrently are left for the next call, so a busy producer cannot keep it running.
+        // fn may push the element it gets back into the queue.
+        template <class Fn>
+        std::size_t PopAll(Fn&& fn)
+        {
+            // The walk ends at the node that was pushed last when the call started. That may be the stub, which
+            // is stepped over and never handed out.
+            auto* last = head_.load(std::memory_order_acquire);
+
+            std::size_t popped = 0;
+            {
+                [[maybe_unused]] const auto guard = consumer_.Enter();
+                while (tail_ != last)
+                {
+                    auto* element = tail_;
+                    auto* next = element->next_.load(std::memory_order_acquire);
+                    if (!next)
+                    {
+                        // A producer has swapped the head but not linked its element yet.
+                        return popped;
+                    }
+
+                    tail_ = next;
+                    if (element != &stub_)
+                    {
+                        ++popped;
+                        fn(static_cast<T*>(element));
+                    }
+                }
+            }
+
+            // The last element has no successor from before the call; Pop() knows how to unlink it.
+            if (last != &stub_)
+            {
+                if (auto* element = Pop())
+                {
+                    ++popped;
+                    fn(element);
+                }
+            }
+
+            return popped;
+        }
+
+        // Consumer-side snapshot.
+        bool Empty() const
+        {
+            return tail_ == &stub_ && !stub_.next_.load(std::memory_order_acquire);
+        }
+
+    private:
+        void Link(MPSCQueueHook* hook)
+        {
+            hook->next_.store(nullptr, std::memory_order_relaxed);
+            auto* previous = head_.exchange(hook, std::memory_order_acq_rel);
+            previous->next_.store(hook, std::memory_order_release);
+        }
+
+    private:
+        alignas(alignment::hardware_destructive_interference_size) std::atomic<MPSCQueueHook*> head_;
+        alignas(alignment::hardware_destructive_interference_size) MPSCQueueHook* tail_;
+        [[no_unique_address]] debug::ExclusiveUse consumer_;
+        MPSCQueueHook stub_;
+    };
+}
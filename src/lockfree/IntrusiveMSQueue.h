@@ -0,0 +1,179 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+#include <Alignment.h>
+#include <Packing.h>
+
+namespace lockfree
+{
+    // Elements of an IntrusiveMSQueue derive from this hook. Copying an element does not copy its link.
+    class MSQueueHook
+    {
+    public:
+        MSQueueHook() = default;
+
+        MSQueueHook(const MSQueueHook&)
+        {
+        }
+
+        MSQueueHook& operator=(const MSQueueHook&)
+        {
+            return *this;
+        }
+
+    private:
+        template <class>
+        friend class IntrusiveMSQueue;
+
+        // Tagged pointer to the next element, see packing::PackPointerWithData.
+        std::atomic<uint64_t> next_{0};
+    };
+
+    // Michael-Scott queue that links the elements themselves, so Push and Pop neither allocate nor move.
+    // The queue owns a stub element that takes the place of the dummy node: it is linked behind the last element
+    // when that one has to be popped, and skipped when it reaches the head. Pop is lock-free apart from the
+    // short window between taking the stub off the head and marking it free again.
+    //
+    // Reclamation: head, tail and every link carry a 16-bit tag that changes on each update, and Push bumps the
+    // tag of the element's own link, so a popped element may be pushed again right away, into this or any
+    // other queue. The memory of an element must stay readable until no thread can still be inside Push or Pop
+    // on this queue, because late threads may read its link: keep elements in a pool or another type-stable
+    // arena and free them only once the queue is quiescent.
+    template <class T>
+    class IntrusiveMSQueue
+    {
+        static_assert(std::is_base_of_v<MSQueueHook, T>, "T must derive from MSQueueHook!");
+
+    public:
+        IntrusiveMSQueue()
+            : head_(packing::PackPointer(&stub_))
+            , tail_(packing::PackPointer(&stub_))
+        {
+        }
+
+        IntrusiveMSQueue(const IntrusiveMSQueue&) = delete;
+        IntrusiveMSQueue& operator=(const IntrusiveMSQueue&) = delete;
+
+        void Push(T* element)
+        {
+            MSQueueHook* hook = element;
+            hook->next_.store(Next(hook->next_.load(std::memory_order_relaxed), nullptr), std::memory_order_relaxed);
+
+            while (true)
+            {
+                auto tail = tail_.load(std::memory_order_acquire);
+                auto* last = Ptr(tail);
+                auto next = last->next_.load(std::memory_order_acquire);
+                if (tail != tail_.load(std::memory_order_acquire))
+                {
+                    continue;
+                }
+
+                if (Ptr(next))
+                {
+                    tail_.compare_exchange_weak(tail, Next(tail, Ptr(next)), std::memory_order_release, std::memory_order_relaxed);
+                    continue;
+                }
+
+                if (last->next_.compare_exchange_weak(next, Next(next, hook), std::memory_order_release, std::memory_order_relaxed))
+                {
+                    tail_.compare_exchange_strong(tail, Next(tail, hook), std::memory_order_release, std::memory_order_relaxed);
+                    return;
+                }
+            }
+        }
+
+        T* Pop()
+        {
+            while (true)
+            {
+                auto head = head_.load(std::memory_order_acquire);
+                auto tail = tail_.load(std::memory_order_acquire);
+                auto* first = Ptr(head);
+                auto next = first->next_.load(std::memory_order_acquire);
+                if (head != head_.load(std::memory_order_acquire))
+                {
+                    continue;
+                }
+
+                if (first == Ptr(tail))
+                {
+                    if (Ptr(next))
+                    {
+                        tail_.compare_exchange_weak(tail, Next(tail, Ptr(next)), std::memory_order_release, std::memory_order_relaxed);
+                    }
+                    else if (first == &stub_)
+                    {
+                        return nullptr;
+                    }
+                    else
+                    {
+                        LinkStub(first, next, tail);
+                    }
+                    continue;
+                }
+
+                if (!Ptr(next))
+                {
+                    continue;
+                }
+
+                if (head_.compare_exchange_weak(head, Next(head, Ptr(next)), std::memory_order_acq_rel, std::memory_order_relaxed))
+                {
+                    if (first == &stub_)
+                    {
+                        stubQueued_.store(false, std::memory_order_release);
+                        continue;
+                    }
+
+                    return static_cast<T*>(first);
+                }
+            }
+        }
+
+        bool Empty() const
+        {
+            const auto head = head_.load(std::memory_order_acquire);
+            auto* first = Ptr(head);
+            return first == &stub_ && !Ptr(first->next_.load(std::memory_order_acquire));
+        }
+
+    private:
+        // Puts the stub behind the only element left, so that the element can leave the queue.
+        void LinkStub(MSQueueHook* last, uint64_t next, uint64_t tail)
+        {
+            if (stubQueued_.exchange(true, std::memory_order_acq_rel))
+            {
+                return;
+            }
+
+            stub_.next_.store(Next(stub_.next_.load(std::memory_order_relaxed), nullptr), std::memory_order_relaxed);
+            if (!last->next_.compare_exchange_strong(next, Next(next, &stub_), std::memory_order_release, std::memory_order_relaxed))
+            {
+                stubQueued_.store(false, std::memory_order_release);
+                return;
+            }
+
+            tail_.compare_exchange_strong(tail, Next(tail, &stub_), std::memory_order_release, std::memory_order_relaxed);
+        }
+
+        static MSQueueHook* Ptr(uint64_t data)
+        {
+            return packing::UnpackPointer<MSQueueHook>(data);
+        }
+
+        static uint64_t Next(uint64_t current, MSQueueHook* hook)
+        {
+            return packing::PackPointerWithData(hook, packing::UnpackData(current) + 1);
+        }
+
+    private:
+        alignas(alignment::hardware_destructive_interference_size) std::atomic<uint64_t> head_;
+        alignas(alignment::hardware_destructive_interference_size) std::atomic<uint64_t> tail_;
+        alignas(alignment::hardware_destructive_interference_size) std::atomic<bool> stubQueued_{true};
+        MSQueueHook stub_;
+    };
+}
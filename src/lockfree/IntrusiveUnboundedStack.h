@@ -0,0 +1,92 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+#include <Packing.h>
+
+namespace lockfree
+{
+    // Elements of an IntrusiveUnboundedStack derive from this hook. Copying an element does not copy its link.
+    class UnboundedStackHook
+    {
+    public:
+        UnboundedStackHook() = default;
+
+        UnboundedStackHook(const UnboundedStackHook&)
+        {
+        }
+
+        UnboundedStackHook& operator=(const UnboundedStackHook&)
+        {
+            return *this;
+        }
+
+    private:
+        template <class>
+        friend class IntrusiveUnboundedStack;
+
+        std::atomic<UnboundedStackHook*> next_{nullptr};
+    };
+
+    // Treiber stack that links the elements themselves, so Push and Pop neither allocate nor move.
+    //
+    // Reclamation: a popped element may be pushed again right away, into this or any other stack; the 16-bit tag
+    // next to the head pointer makes a Pop that raced with such a reuse fail its CAS. The memory of an element
+    // must stay readable until no thread can still be inside Pop on this stack, because a late Pop may read its
+    // link: keep elements in a pool or another type-stable arena and free them only once the stack is quiescent.
+    template <class T>
+    class IntrusiveUnboundedStack
+    {
+        static_assert(std::is_base_of_v<UnboundedStackHook, T>, "T must derive from UnboundedStackHook!");
+
+    public:
+        void Push(T* element)
+        {
+            UnboundedStackHook* hook = element;
+            auto head = head_.load(std::memory_order_relaxed);
+            do
+            {
+                hook->next_.store(Ptr(head), std::memory_order_relaxed);
+            }
+            while (!head_.compare_exchange_weak(head, Next(head, hook), std::memory_order_release, std::memory_order_relaxed));
+        }
+
+        T* Pop()
+        {
+            auto head = head_.load(std::memory_order_acquire);
+            UnboundedStackHook* hook;
+            do
+            {
+                hook = Ptr(head);
+                if (!hook)
+                {
+                    return nullptr;
+                }
+            }
+            while (!head_.compare_exchange_weak(head, Next(head, hook->next_.load(std::memory_order_relaxed)), std::memory_order_acquire, std::memory_order_acquire));
+
+            return static_cast<T*>(hook);
+        }
+
+        bool Empty() const
+        {
+            return !Ptr(head_.load(std::memory_order_acquire));
+        }
+
+    private:
+        static UnboundedStackHook* Ptr(uint64_t data)
+        {
+            return packing::UnpackPointer<UnboundedStackHook>(data);
+        }
+
+        static uint64_t Next(uint64_t current, UnboundedStackHook* hook)
+        {
+            return packing::PackPointerWithData(hook, packing::UnpackData(current) + 1);
+        }
+
+    private:
+        std::atomic<uint64_t> head_{0};
+    };
+}
@@ -2,15 +2,20 @@
 
 #include <atomic>
 #include <cstddef>
+#include <memory>
 #include <optional>
+#include <utility>
 #include <vector>
 
 #include <Alignment.h>
+#include <Backoff.h>
 #include <Math.h>
 
 namespace lockfree
 {
-    template <class T, std::size_t Capacity>
+    // Allocator decides where the cells live, e.g. numa::NodeAllocator to keep them on the consumers' node.
+    // Backoff is one of the policies from Backoff.h, applied whenever another thread wins the slot.
+    template <class T, std::size_t Capacity, class Allocator = std::allocator<T>, class Backoff = backoff::Default>
     class MPMCRingBuffer
     {
         static_assert(Capacity > 1, "Capacity is too small!");
@@ -22,8 +27,11 @@ namespace lockfree
             std::atomic<uint64_t> sequence;
         };
 
+        using CellAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Cell>;
+
     public:
-        MPMCRingBuffer()
+        explicit MPMCRingBuffer(const Allocator& allocator = Allocator())
+            : data_(Capacity, CellAllocator(allocator))
         {
             for (std::size_t i = 0; i < data_.size(); ++i)
             {
@@ -31,63 +39,85 @@ namespace lockfree
             }
         }
 
-        bool Push(T data)
+        // The value is left untouched when the buffer is full.
+        bool Push(const T& data)
+        {
+            return Emplace(data);
+        }
+
+        bool Push(T&& data)
         {
+            return Emplace(std::move(data));
+        }
+
+        std::optional<T> Pop()
+        {
+            Backoff backoff;
             while (true)
             {
-                auto pos = enqueue_pos_.load(std::memory_order_relaxed);
+                auto pos = dequeue_pos_.load(std::memory_order_relaxed);
                 auto& cell = data_[Index(pos)];
                 auto sequence = cell.sequence.load(std::memory_order_acquire);
 
-                const auto dif = static_cast<int64_t>(sequence) - static_cast<int64_t>(pos);
+                auto dif = static_cast<int64_t>(sequence) - static_cast<int64_t>(pos + 1);
                 if (dif < 0)
                 {
-                    return false;
+                    return std::nullopt;
                 }
 
-                if (dif != 0)
+                if (dif == 0 && dequeue_pos_.compare_exchange_strong(pos, pos + 1, std::memory_order_relaxed))
                 {
-                    continue;
+                    auto result = std::make_optional(std::move(cell.data));
+                    cell.sequence.store(pos + Capacity, std::memory_order_release);
+                    return result;
                 }
 
-                if (enqueue_pos_.compare_exchange_strong(pos, pos + 1, std::memory_order_relaxed))
-                {
-                    cell.data = std::move(data);
-                    cell.sequence.store(sequence + 1, std::memory_order_release);
-                    return true;
-                }
+                backoff.Wait();
             }
         }
 
-        std::optional<T> Pop()
+        bool Empty() const
         {
+            const auto pos = dequeue_pos_.load(std::memory_order_acquire);
+            const auto sequence = data_[Index(pos)].sequence.load(std::memory_order_acquire);
+            return static_cast<int64_t>(sequence) - static_cast<int64_t>(pos + 1) < 0;
+        }
+
+        bool Full() const
+        {
+            const auto pos = enqueue_pos_.load(std::memory_order_acquire);
+            const auto sequence = data_[Index(pos)].sequence.load(std::memory_order_acquire);
+            return static_cast<int64_t>(sequence) - static_cast<int64_t>(pos) < 0;
+        }
+
+    private:
+        template <class U>
+        bool Emplace(U&& data)
+        {
+            Backoff backoff;
             while (true)
             {
-                auto pos = dequeue_pos_.load(std::memory_order_relaxed);
+                auto pos = enqueue_pos_.load(std::memory_order_relaxed);
                 auto& cell = data_[Index(pos)];
                 auto sequence = cell.sequence.load(std::memory_order_acquire);
 
-                auto dif = static_cast<int64_t>(sequence) - static_cast<int64_t>(pos + 1);
+                const auto dif = static_cast<int64_t>(sequence) - static_cast<int64_t>(pos);
                 if (dif < 0)
                 {
-                    return std::nullopt;
+                    return false;
                 }
 
-                if (dif != 0)
+                if (dif == 0 && enqueue_pos_.compare_exchange_strong(pos, pos + 1, std::memory_order_relaxed))
                 {
-                    continue;
+                    cell.data = std::forward<U>(data);
+                    cell.sequence.store(sequence + 1, std::memory_order_release);
+                    return true;
                 }
 
-                if (dequeue_pos_.compare_exchange_strong(pos, pos + 1, std::memory_order_relaxed))
-                {
-                    auto result = std::make_optional(std::move(cell.data));
-                    cell.sequence.store(pos + Capacity, std::memory_order_release);
-                    return result;
-                }
+                backoff.Wait();
             }
         }
 
-    private:
         static constexpr std::size_t Index(std::size_t index)
         {
             return index & (Capacity - 1);
@@ -96,6 +126,6 @@ namespace lockfree
     private:
         alignas(alignment::hardware_destructive_interference_size) std::atomic<std::size_t> dequeue_pos_{0};
         alignas(alignment::hardware_destructive_interference_size) std::atomic<std::size_t> enqueue_pos_{0};
-        std::vector<Cell> data_ = std::vector<Cell>(Capacity);
+        std::vector<Cell, CellAllocator> data_;
     };
 }
@@ -2,9 +2,12 @@
 #include <atomic>
 #include <optional>
 
+#include <Backoff.h>
+
 namespace lockfree
 {
-    template <class T>
+    // Backoff is one of the policies from Backoff.h, applied after every lost CAS.
+    template <class T, class Backoff = backoff::Default>
     class MSQueue
     {
         struct Node
@@ -33,6 +36,7 @@ namespace lockfree
             Node* newTail = new Node{ .value = std::move(value) };
             Node* currentTail;
 
+            Backoff backoff;
             while (true)
             {
                 currentTail = m_tail.load();
@@ -45,6 +49,8 @@ namespace lockfree
                 Node* empty = nullptr;
                 if (currentTail->next.compare_exchange_weak(empty, newTail))
                     break;
+
+                backoff.Wait();
             }
 
             m_tail.compare_exchange_strong(currentTail, newTail);
@@ -52,6 +58,7 @@ namespace lockfree
 
         std::optional<T> Pop()
         {
+            Backoff backoff;
             while (true)
             {
                 auto* currentHead = m_head.load();
@@ -71,8 +78,10 @@ namespace lockfree
                     Node* next = currentHead->next;
                     T value = std::move(next->value);
                     //delete current;
-                    return std::move(value);
+                    return value;
                 }
+
+                backoff.Wait();
             }
         }
 
@@ -0,0 +1,201 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+#include <Alignment.h>
+#include <Backoff.h>
+#include <Math.h>
+
+namespace lockfree
+{
+    // Flight-recorder ring: Push never fails, it overwrites the oldest entry instead. Any number of producers,
+    // one consumer. Every cell carries the sequence number of the entry it holds, like MPMCRingBuffer, and the
+    // value lives in atomic words like SeqLock, so the consumer can tell a cell that was overwritten while it
+    // was being copied and skip it. Entries come out with their sequence number; Overwritten() counts the ones
+    // the consumer never got to see.
+    template <class T, std::size_t Capacity>
+    class OverwritingRingBuffer
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "OverwritingRingBuffer needs a trivially copyable type!");
+        static_assert(Capacity > 1, "Capacity is too small!");
+        static_assert(math::IsPowerOf2(Capacity), "Capacity must be a power of 2!");
+
+        static constexpr std::size_t kWords = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+        using Words = std::array<uint64_t, kWords>;
+
+        // A cell stamp is (sequence + 1) << 1 with the low bit set while a producer writes it; 0 is empty.
+        struct Cell
+        {
+            std::atomic<uint64_t> stamp{0};
+            std::array<std::atomic<uint64_t>, kWords> words{};
+        };
+
+    public:
+        struct Entry
+        {
+            uint64_t sequence;
+            T value;
+        };
+
+        void Push(const T& value)
+        {
+            const auto sequence = enqueue_pos_.fetch_add(1, std::memory_order_relaxed);
+            auto& cell = cells_[Index(sequence)];
+
+            backoff::Pause backoff;
+            auto stamp = cell.stamp.load(std::memory_order_relaxed);
+            while (true)
+            {
+                // A producer a whole lap ahead already owns the cell; our entry is overwritten before it was
+                // ever written.
+                if ((stamp >> 1) > sequence + 1)
+                {
+                    return;
+                }
+
+                // A producer a whole lap behind is still copying into the cell. Only happens when the ring
+                // wraps within a single Push.
+                if (stamp & 1)
+                {
+                    backoff.Wait();
+                    stamp = cell.stamp.load(std::memory_order_relaxed);
+                    continue;
+                }
+
+                // Acquire so our words are ordered after the previous owner's, which a consumer may still be
+                // validating against the stamp we replace.
+                if (cell.stamp.compare_exchange_weak(stamp, Writing(sequence), std::memory_order_acquire, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+
+            const auto words = ToWords(value);
+            for (std::size_t i = 0; i < kWords; ++i)
+            {
+                cell.words[i].store(words[i], std::memory_order_release);
+            }
+
+            cell.stamp.store(Written(sequence), std::memory_order_release);
+        }
+
+        // Entries come out in sequence order, so Pop does not look past an entry whose producer has taken its
+        // sequence but not finished writing it. It waits a few pauses for that producer and then returns
+        // std::nullopt even if later entries are ready; the entry is picked up by a later Pop.
+        std::optional<Entry> Pop()
+        {
+            while (true)
+            {
+                const auto tail = enqueue_pos_.load(std::memory_order_acquire);
+                if (dequeue_pos_ == tail)
+                {
+                    return std::nullopt;
+                }
+
+                if (tail - dequeue_pos_ > Capacity)
+                {
+                    Skip(tail - Capacity - dequeue_pos_);
+                }
+
+                const auto sequence = dequeue_pos_;
+                const auto& cell = cells_[Index(sequence)];
+                auto stamp = cell.stamp.load(std::memory_order_acquire);
+                for (int polls = 0; polls < kUnwrittenPolls && stamp != Written(sequence) && (stamp >> 1) <= sequence + 1; ++polls)
+                {
+                    backoff::Pause().Wait();
+                    stamp = cell.stamp.load(std::memory_order_acquire);
+                }
+
+                if ((stamp >> 1) > sequence + 1)
+                {
+                    Skip(1);
+                    continue;
+                }
+
+                // Claimed but still not written.
+                if (stamp != Written(sequence))
+                {
+                    return std::nullopt;
+                }
+
+                Words words;
+                for (std::size_t i = 0; i < kWords; ++i)
+                {
+                    words[i] = cell.words[i].load(std::memory_order_acquire);
+                }
+
+                // Torn: a producer a lap ahead started on the cell while we were copying it.
+                if (cell.stamp.load(std::memory_order_relaxed) != stamp)
+                {
+                    Skip(1);
+                    continue;
+                }
+
+                ++dequeue_pos_;
+                return Entry{sequence, FromWords(words)};
+            }
+        }
+
+        uint64_t Pushed() const
+        {
+            return enqueue_pos_.load(std::memory_order_relaxed);
+        }
+
+        uint64_t Overwritten() const
+        {
+            return overwritten_.load(std::memory_order_relaxed);
+        }
+
+    private:
+        static constexpr int kUnwrittenPolls = 64;
+
+        static constexpr uint64_t Written(uint64_t sequence)
+        {
+            return (sequence + 1) << 1;
+        }
+
+        static constexpr uint64_t Writing(uint64_t sequence)
+        {
+            return Written(sequence) | 1;
+        }
+
+        static constexpr std::size_t Index(uint64_t sequence)
+        {
+            return sequence & (Capacity - 1);
+        }
+
+        static Words ToWords(const T& value)
+        {
+            Words words{};
+            std::memcpy(words.data(), &value, sizeof(T));
+            return words;
+        }
+
+        static T FromWords(const Words& words)
+        {
+            std::array<std::byte, sizeof(T)> bytes;
+            std::memcpy(bytes.data(), words.data(), sizeof(T));
+            return std::bit_cast<T>(bytes);
+        }
+
+        void Skip(uint64_t amount)
+        {
+            dequeue_pos_ += amount;
+            overwritten_.store(overwritten_.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+        }
+
+    private:
+        alignas(alignment::hardware_destructive_interference_size) std::atomic<uint64_t> enqueue_pos_{0};
+        alignas(alignment::hardware_destructive_interference_size) uint64_t dequeue_pos_ = 0;
+        std::atomic<uint64_t> overwritten_{0};
+        std::vector<Cell> cells_ = std::vector<Cell>(Capacity);
+    };
+}
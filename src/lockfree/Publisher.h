@@ -0,0 +1,184 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <Alignment.h>
+#include <ThreadRegistry.h>
+
+namespace lockfree
+{
+    // RCU-style holder of an immutable snapshot. Readers pin the current epoch in a slot of their own and load the
+    // snapshot pointer, so a read writes only to the reader's own cache line. A writer swaps in a new snapshot and
+    // frees the old one once every reader that could still see it has dropped its Snapshot (the grace period).
+    // Reader slots come from ThreadRegistry<MaxReaders>, shared by every Publisher with the same MaxReaders.
+    template <class T, std::size_t MaxReaders = 64>
+    class Publisher
+    {
+        static constexpr uint64_t kInactive = 0;
+
+        struct alignas(alignment::hardware_destructive_interference_size) ReaderSlot
+        {
+            std::atomic<uint64_t> epoch{kInactive};
+            // Only touched by the owning thread; makes nested reads cheap.
+            std::size_t depth = 0;
+        };
+
+        struct Retired
+        {
+            const T* snapshot;
+            uint64_t epoch;
+        };
+
+    public:
+        // Keeps the snapshot alive while it exists. Must be dropped on the thread that took it.
+        class Snapshot
+        {
+        public:
+            Snapshot(const Snapshot&) = delete;
+            Snapshot& operator=(const Snapshot&) = delete;
+
+            ~Snapshot()
+            {
+                if (--slot_.depth == 0)
+                {
+                    slot_.epoch.store(kInactive, std::memory_order_release);
+                }
+            }
+
+            const T& operator*() const
+            {
+                return *snapshot_;
+            }
+
+            const T* operator->() const
+            {
+                return snapshot_;
+            }
+
+            const T* Get() const
+            {
+                return snapshot_;
+            }
+
+        private:
+            friend class Publisher;
+
+            Snapshot(ReaderSlot& slot, const T* snapshot)
+                : slot_(slot)
+                , snapshot_(snapshot)
+            {
+            }
+
+        private:
+            ReaderSlot& slot_;
+            const T* snapshot_;
+        };
+
+        explicit Publisher(std::unique_ptr<const T> initial)
+            : current_(initial.release())
+        {
+        }
+
+        Publisher(const Publisher&) = delete;
+        Publisher& operator=(const Publisher&) = delete;
+
+        // No reader may hold a Snapshot any more.
+        ~Publisher()
+        {
+            delete current_.load(std::memory_order_relaxed);
+            for (const auto& retired : retired_)
+            {
+                delete retired.snapshot;
+            }
+        }
+
+        Snapshot Read() const
+        {
+            auto& slot = slots_[ThreadRegistry<MaxReaders>::Index()];
+            if (slot.depth++ == 0)
+            {
+                slot.epoch.store(epoch_.load(std::memory_order_acquire));
+            }
+
+            return Snapshot(slot, current_.load());
+        }
+
+        void Publish(std::unique_ptr<const T> snapshot)
+        {
+            std::lock_guard guard(writer_);
+            const auto* old = current_.exchange(snapshot.release());
+            retired_.push_back({.snapshot = old, .epoch = epoch_.fetch_add(1) + 1});
+            Reclaim();
+        }
+
+        template <class... Args>
+        void Emplace(Args&&... args)
+        {
+            Publish(std::make_unique<const T>(std::forward<Args>(args)...));
+        }
+
+        // Waits out the grace period of every snapshot replaced so far and frees them.
+        void Synchronize()
+        {
+            std::lock_guard guard(writer_);
+            while (!retired_.empty())
+            {
+                Reclaim();
+                if (!retired_.empty())
+                {
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+        // Replaced snapshots still waiting for their grace period.
+        std::size_t Pending() const
+        {
+            std::lock_guard guard(writer_);
+            return retired_.size();
+        }
+
+    private:
+        void Reclaim()
+        {
+            // Readers that pinned an epoch before a snapshot was retired may still hold it.
+            auto oldest = UINT64_MAX;
+            for (const auto& slot : slots_)
+            {
+                const auto epoch = slot.epoch.load();
+                if (epoch != kInactive)
+                {
+                    oldest = std::min(oldest, epoch);
+                }
+            }
+
+            const auto end = std::remove_if(retired_.begin(), retired_.end(), [oldest](const Retired& retired)
+            {
+                if (retired.epoch > oldest)
+                {
+                    return false;
+                }
+
+                delete retired.snapshot;
+                return true;
+            });
+            retired_.erase(end, retired_.end());
+        }
+
+    private:
+        alignas(alignment::hardware_destructive_interference_size) std::atomic<const T*> current_;
+        alignas(alignment::hardware_destructive_interference_size) std::atomic<uint64_t> epoch_{1};
+        mutable std::array<ReaderSlot, MaxReaders> slots_;
+        mutable std::mutex writer_;
+        std::vector<Retired> retired_;
+    };
+}
@@ -1,40 +1,76 @@
 #pragma once
 
+#include <algorithm>
 #include <atomic>
 #include <cstddef>
+#include <memory>
 #include <optional>
+#include <span>
+#include <utility>
 #include <vector>
 
 #include <Alignment.h>
+#include <Debug.h>
 #include <Math.h>
 
 namespace lockfree
 {
-    template <class T, std::size_t Capacity>
+    // Allocator decides where the slots live, e.g. numa::NodeAllocator to keep them on the consumer's node.
+    // The consumer's words (head and its cached tail) come first in the object, the producer's follow at the
+    // next IndexAlignment boundary. With a page as IndexAlignment each side's words get a page of their own,
+    // which can then be bound to that side's node (see numa::BindToNode).
+    template <class T, std::size_t Capacity, class Allocator = std::allocator<T>,
+        std::size_t IndexAlignment = alignment::hardware_destructive_interference_size>
     class SPSCRingBuffer
     {
         static_assert(math::IsPowerOf2(Capacity), "Size must be a power of 2");
+        static_assert(math::IsPowerOf2(IndexAlignment) && IndexAlignment >= alignment::hardware_destructive_interference_size,
+            "Index alignment must be a power of 2 of at least a cache line");
 
     public:
-        bool Push(T data)
+        explicit SPSCRingBuffer(const Allocator& allocator = Allocator())
+            : data_(Capacity, allocator)
         {
-            auto tail = tail_.load(std::memory_order_relaxed);
-            if (tail - head_cached_ == Capacity)
+        }
+
+        // The value is left untouched when the buffer is full.
+        bool Push(const T& data)
+        {
+            return Emplace(data);
+        }
+
+        bool Push(T&& data)
+        {
+            return Emplace(std::move(data));
+        }
+
+        // Moves as many values as fit, in order, and publishes them all with a single store. Returns how many
+        // were taken; the rest are left untouched.
+        std::size_t PushBatch(std::span<T> values)
+        {
+            [[maybe_unused]] const auto guard = producer_.Enter();
+            const auto tail = tail_.load(std::memory_order_relaxed);
+            if (Capacity - (tail - head_cached_) < values.size())
             {
                 head_cached_ = head_.load(std::memory_order_acquire);
-                if (tail - head_cached_ == Capacity)
-                {
-                    return false;
-                }
             }
 
-            data_[Index(tail)] = std::move(data);
-            tail_.store(tail + 1, std::memory_order_release);
-            return true;
+            const auto amount = std::min(values.size(), Capacity - (tail - head_cached_));
+            for (std::size_t i = 0; i < amount; ++i)
+            {
+                data_[Index(tail + i)] = std::move(values[i]);
+            }
+
+            if (amount > 0)
+            {
+                tail_.store(tail + amount, std::memory_order_release);
+            }
+            return amount;
         }
 
         std::optional<T> Pop()
         {
+            [[maybe_unused]] const auto guard = consumer_.Enter();
             auto head = head_.load(std::memory_order_relaxed);
             if (head == tail_cached_)
             {
@@ -50,18 +86,49 @@ namespace lockfree
             return data;
         }
 
+        bool Empty() const
+        {
+            return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+        }
+
+        bool Full() const
+        {
+            return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire) == Capacity;
+        }
+
     private:
+        template <class U>
+        bool Emplace(U&& data)
+        {
+            [[maybe_unused]] const auto guard = producer_.Enter();
+            auto tail = tail_.load(std::memory_order_relaxed);
+            if (tail - head_cached_ == Capacity)
+            {
+                head_cached_ = head_.load(std::memory_order_acquire);
+                if (tail - head_cached_ == Capacity)
+                {
+                    return false;
+                }
+            }
+
+            data_[Index(tail)] = std::forward<U>(data);
+            tail_.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
         static constexpr std::size_t Index(std::size_t index)
         {
             return index & (Capacity - 1);
         }
 
     private:
-        alignas(alignment::hardware_destructive_interference_size) std::atomic<std::size_t> head_{0};
-        alignas(alignment::hardware_destructive_interference_size) std::size_t head_cached_{0};
-        alignas(alignment::hardware_destructive_interference_size) std::atomic<std::size_t> tail_{0};
+        alignas(IndexAlignment) std::atomic<std::size_t> head_{0};
         alignas(alignment::hardware_destructive_interference_size) std::size_t tail_cached_{0};
-        std::vector<T> data_ = std::vector<T>(Capacity);
+        [[no_unique_address]] debug::ExclusiveUse consumer_;
+        alignas(IndexAlignment) std::atomic<std::size_t> tail_{0};
+        alignas(alignment::hardware_destructive_interference_size) std::size_t head_cached_{0};
+        [[no_unique_address]] debug::ExclusiveUse producer_;
+        std::vector<T, Allocator> data_;
     };
 
 }
@@ -2,9 +2,15 @@
 
 #include <atomic>
 #include <optional>
+#include <utility>
+
+#include <Alignment.h>
+#include <Debug.h>
 
 namespace lockfree
 {
+    // Linked list with a dummy head. Only the producer touches tail_ and only the consumer touches head_,
+    // so neither side needs a read-modify-write; a node is freed by the consumer once it becomes the dummy.
     template <class T>
     class SPSCUnboundedQueue
     {
@@ -16,45 +22,48 @@ namespace lockfree
 
     public:
         SPSCUnboundedQueue()
+            : head_(new Node{})
+            , tail_(head_)
         {
-            auto* dummy = new Node{};
-            head_.store(dummy, std::memory_order_relaxed);
-            tail_.store(dummy, std::memory_order_relaxed);
         }
 
+        SPSCUnboundedQueue(const SPSCUnboundedQueue&) = delete;
+        SPSCUnboundedQueue& operator=(const SPSCUnboundedQueue&) = delete;
+
         ~SPSCUnboundedQueue()
         {
-            while (head_.load(std::memory_order_relaxed))
+            while (head_)
             {
-                delete head_.exchange(head_.load()->next, std::memory_order_relaxed);
+                delete std::exchange(head_, head_->next.load(std::memory_order_relaxed));
             }
         }
 
         void Push(T data)
         {
+            [[maybe_unused]] const auto guard = producer_.Enter();
             auto* node = new Node{ .value = std::move(data) };
-            while (true)
-            {
-                auto tail = tail_.load(std::memory_order_relaxed);
-                Node* null_ptr = nullptr;
-                if (!tail->next.compare_exchange_weak(null_ptr, node, std::memory_order_release, std::memory_order_relaxed))
-                {
-                    continue;
-                }
-
-                tail_.compare_exchange_strong(tail, node, std::memory_order_release, std::memory_order_relaxed);
-                break;
-            }
+            tail_->next.store(node, std::memory_order_release);
+            tail_ = node;
         }
 
         std::optional<T> Pop()
         {
+            [[maybe_unused]] const auto guard = consumer_.Enter();
+            auto* next = head_->next.load(std::memory_order_acquire);
+            if (!next)
+            {
+                return std::nullopt;
+            }
 
+            auto data = std::move(next->value);
+            delete std::exchange(head_, next);
+            return data;
         }
 
-
     private:
-        std::atomic<Node*> head_ = nullptr;
-        std::atomic<Node*> tail_ = nullptr;
+        alignas(alignment::hardware_destructive_interference_size) Node* head_;
+        [[no_unique_address]] debug::ExclusiveUse consumer_;
+        alignas(alignment::hardware_destructive_interference_size) Node* tail_;
+        [[no_unique_address]] debug::ExclusiveUse producer_;
     };
-}
\ No newline at end of file
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <thread>
+#include <type_traits>
+
+#include <Alignment.h>
+
+namespace lockfree
+{
+    // Sequence lock for small trivially copyable values. Readers never write shared memory: they copy the value
+    // optimistically and retry when a writer was active meanwhile. The value is kept in atomic words, so a torn
+    // read is discarded instead of being a data race; acquire/release on the words orders them against the
+    // sequence without fences, which costs nothing on x86. Writers exclude each other on the sequence word.
+    template <class T>
+    class SeqLock
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "SeqLock needs a trivially copyable type!");
+
+        static constexpr std::size_t kWords = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+        using Words = std::array<uint64_t, kWords>;
+
+    public:
+        SeqLock() requires std::is_default_constructible_v<T>
+            : SeqLock(T{})
+        {
+        }
+
+        explicit SeqLock(const T& value)
+        {
+            const auto words = ToWords(value);
+            for (std::size_t i = 0; i < kWords; ++i)
+            {
+                words_[i].store(words[i], std::memory_order_relaxed);
+            }
+        }
+
+        T Load() const
+        {
+            while (true)
+            {
+                if (auto value = TryLoad())
+                {
+                    return *value;
+                }
+                std::this_thread::yield();
+            }
+        }
+
+        // Single attempt; fails when it overlapped with a Store.
+        std::optional<T> TryLoad() const
+        {
+            const auto before = sequence_.load(std::memory_order_acquire);
+            if (before & 1)
+            {
+                return std::nullopt;
+            }
+
+            Words words;
+            for (std::size_t i = 0; i < kWords; ++i)
+            {
+                words[i] = words_[i].load(std::memory_order_acquire);
+            }
+
+            if (sequence_.load(std::memory_order_relaxed) != before)
+            {
+                return std::nullopt;
+            }
+
+            return FromWords(words);
+        }
+
+        void Store(const T& value)
+        {
+            // Acquire on success orders our word stores after the previous writer's, which released the sequence.
+            auto sequence = sequence_.load(std::memory_order_relaxed);
+            while ((sequence & 1) || !sequence_.compare_exchange_weak(sequence, sequence + 1, std::memory_order_acquire, std::memory_order_relaxed))
+            {
+                sequence = sequence_.load(std::memory_order_relaxed);
+            }
+
+            const auto words = ToWords(value);
+            for (std::size_t i = 0; i < kWords; ++i)
+            {
+                words_[i].store(words[i], std::memory_order_release);
+            }
+
+            sequence_.store(sequence + 2, std::memory_order_release);
+        }
+
+    private:
+        static Words ToWords(const T& value)
+        {
+            Words words{};
+            std::memcpy(words.data(), &value, sizeof(T));
+            return words;
+        }
+
+        static T FromWords(const Words& words)
+        {
+            std::array<std::byte, sizeof(T)> bytes;
+            std::memcpy(bytes.data(), words.data(), sizeof(T));
+            return std::bit_cast<T>(bytes);
+        }
+
+    private:
+        alignas(alignment::hardware_destructive_interference_size) std::atomic<uint64_t> sequence_{0};
+        std::array<std::atomic<uint64_t>, kWords> words_{};
+    };
+}
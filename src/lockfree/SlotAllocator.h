@@ -0,0 +1,202 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+
+#include <Alignment.h>
+
+namespace lockfree
+{
+    // Hands out indexes into a fixed table of Capacity objects. A set bit in words_ is a free slot, and a set
+    // bit in summary_ says that the matching word may have free bits, so a search skips 64 full words per
+    // summary bit. Each thread starts searching where it last found a slot, which keeps threads on different
+    // words. Nothing allocates. Allocate() can miss slots that are freed while it is already scanning past
+    // them, so it may report a nearly full table as full.
+    template <std::size_t Capacity>
+    class SlotAllocator
+    {
+        static_assert(Capacity > 0, "Capacity must be positive!");
+
+        static constexpr std::size_t kBits = 64;
+        static constexpr std::size_t kWords = (Capacity + kBits - 1) / kBits;
+        static constexpr std::size_t kSummaryWords = (kWords + kBits - 1) / kBits;
+
+    public:
+        SlotAllocator()
+        {
+            for (std::size_t i = 0; i < kWords; ++i)
+            {
+                const auto bits = std::min(kBits, Capacity - i * kBits);
+                words_[i].store(bits == kBits ? ~uint64_t{0} : (uint64_t{1} << bits) - 1, std::memory_order_relaxed);
+                summary_[i / kBits].fetch_or(Bit(i), std::memory_order_relaxed);
+            }
+        }
+
+        SlotAllocator(const SlotAllocator&) = delete;
+        SlotAllocator& operator=(const SlotAllocator&) = delete;
+
+        std::optional<std::size_t> Allocate()
+        {
+            std::size_t index = 0;
+            if (Allocate(std::span(&index, 1)) == 0)
+            {
+                return std::nullopt;
+            }
+            return index;
+        }
+
+        // Fills out with free slots, taking as many as possible from a word with a single CAS. Returns how many
+        // were allocated; fewer than out.size() means the table ran out.
+        std::size_t Allocate(std::span<std::size_t> out)
+        {
+            std::size_t allocated = 0;
+            if (out.empty())
+            {
+                return allocated;
+            }
+
+            auto& hint = Hint();
+            const auto startSummary = hint / kBits;
+            for (std::size_t step = 0; step <= kSummaryWords; ++step)
+            {
+                const auto summaryIndex = (startSummary + step) % kSummaryWords;
+                auto candidates = summary_[summaryIndex].load(std::memory_order_acquire);
+                if (step == 0)
+                {
+                    // Start at the hint, the words below it get their turn in the last step.
+                    candidates &= ~(Bit(hint) - 1);
+                }
+                else if (step == kSummaryWords)
+                {
+                    candidates &= Bit(hint) - 1;
+                }
+
+                while (candidates)
+                {
+                    const auto word = summaryIndex * kBits + std::countr_zero(candidates);
+                    candidates &= candidates - 1;
+
+                    allocated += Claim(word, out.subspan(allocated));
+                    if (allocated == out.size())
+                    {
+                        hint = word;
+                        return allocated;
+                    }
+                }
+            }
+
+            return allocated;
+        }
+
+        void Free(std::size_t index)
+        {
+            Release(index / kBits, Bit(index));
+        }
+
+        // Slots from the same word are given back with a single RMW, so free them sorted when possible.
+        void Free(std::span<const std::size_t> indexes)
+        {
+            std::size_t i = 0;
+            while (i < indexes.size())
+            {
+                const auto word = indexes[i] / kBits;
+                uint64_t mask = 0;
+                for (; i < indexes.size() && indexes[i] / kBits == word; ++i)
+                {
+                    mask |= Bit(indexes[i]);
+                }
+                Release(word, mask);
+            }
+        }
+
+        // Exact only while nobody allocates or frees.
+        std::size_t Available() const
+        {
+            std::size_t available = 0;
+            for (const auto& word : words_)
+            {
+                available += std::popcount(word.load(std::memory_order_relaxed));
+            }
+            return available;
+        }
+
+    private:
+        static constexpr uint64_t Bit(std::size_t index)
+        {
+            return uint64_t{1} << (index % kBits);
+        }
+
+        std::size_t& Hint()
+        {
+            // Threads start on different words in first-come order, spread over the whole table.
+            static std::atomic<std::size_t> next{0};
+            thread_local std::size_t hint = next.fetch_add(1, std::memory_order_relaxed) * (kWords / 8 + 1) % kWords;
+            return hint;
+        }
+
+        std::size_t Claim(std::size_t word, std::span<std::size_t> out)
+        {
+            auto bits = words_[word].load(std::memory_order_relaxed);
+            uint64_t taken = 0;
+            while (true)
+            {
+                taken = LowestBits(bits, out.size());
+                if (!bits || words_[word].compare_exchange_weak(bits, bits & ~taken, std::memory_order_acquire, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+
+            if (bits == taken)
+            {
+                // The word is empty now (or already was). Drop it from the summary, but put it back if a slot was
+                // freed in between: that Release() may have set the summary bit before we cleared it.
+                summary_[word / kBits].fetch_and(~Bit(word), std::memory_order_acq_rel);
+                if (words_[word].load(std::memory_order_acquire))
+                {
+                    summary_[word / kBits].fetch_or(Bit(word), std::memory_order_acq_rel);
+                }
+            }
+
+            std::size_t claimed = 0;
+            while (taken)
+            {
+                out[claimed++] = word * kBits + std::countr_zero(taken);
+                taken &= taken - 1;
+            }
+            return claimed;
+        }
+
+        static uint64_t LowestBits(uint64_t bits, std::size_t amount)
+        {
+            uint64_t lowest = 0;
+            for (; bits && amount > 0; --amount)
+            {
+                lowest |= bits & -bits;
+                bits &= bits - 1;
+            }
+            return lowest;
+        }
+
+        void Release(std::size_t word, uint64_t mask)
+        {
+            [[maybe_unused]] const auto previous = words_[word].fetch_or(mask, std::memory_order_release);
+            assert(!(previous & mask) && "Slot is freed twice!");
+            if (!previous)
+            {
+                summary_[word / kBits].fetch_or(Bit(word), std::memory_order_acq_rel);
+            }
+        }
+
+    private:
+        alignas(alignment::hardware_destructive_interference_size) std::array<std::atomic<uint64_t>, kSummaryWords> summary_{};
+        alignas(alignment::hardware_destructive_interference_size) std::array<std::atomic<uint64_t>, kWords> words_{};
+    };
+}
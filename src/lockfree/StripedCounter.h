@@ -0,0 +1,174 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <limits>
+
+#include <Alignment.h>
+#include <Math.h>
+
+namespace lockfree
+{
+    namespace detail
+    {
+        // Threads get consecutive seeds that are never handed back: threads started together spread evenly over
+        // the cells, but once threads come and go, live ones may share a cell. Sharing only costs contention.
+        inline std::size_t StripeSeed()
+        {
+            static std::atomic<std::size_t> next{0};
+            thread_local const auto seed = next.fetch_add(1, std::memory_order_relaxed);
+            return seed;
+        }
+
+        template <class T, std::size_t Stripes>
+        class StripedCells
+        {
+            static_assert(math::IsPowerOf2(Stripes), "Stripes must be a power of 2");
+
+            struct alignas(alignment::hardware_destructive_interference_size) Cell
+            {
+                std::atomic<T> value;
+            };
+
+        public:
+            explicit StripedCells(T initial)
+                : initial_(initial)
+            {
+                Reset();
+            }
+
+            std::atomic<T>& Local()
+            {
+                return cells_[StripeSeed() & (Stripes - 1)].value;
+            }
+
+            template <class Fn>
+            T Fold(Fn&& fn) const
+            {
+                auto result = initial_;
+                for (const auto& cell : cells_)
+                {
+                    result = fn(result, cell.value.load(std::memory_order_relaxed));
+                }
+                return result;
+            }
+
+            void Reset()
+            {
+                for (auto& cell : cells_)
+                {
+                    cell.value.store(initial_, std::memory_order_relaxed);
+                }
+            }
+
+        private:
+            const T initial_;
+            std::array<Cell, Stripes> cells_;
+        };
+    }
+
+    // LongAdder-style counter: every thread adds to its own cache line and Load() sums them up. Adding is as
+    // cheap as an uncontended fetch_add; reading touches every stripe, so read it rarely. Load() is exact once
+    // the writers are quiet, while they run it is some value between the counts at its start and end.
+    template <std::size_t Stripes = 16>
+    class StripedCounter
+    {
+    public:
+        void Add(std::size_t amount)
+        {
+            cells_.Local().fetch_add(amount, std::memory_order_relaxed);
+        }
+
+        void Increment()
+        {
+            Add(1);
+        }
+
+        std::size_t Load() const
+        {
+            return cells_.Fold(std::plus<>{});
+        }
+
+        // Concurrent Add()s may survive or be lost.
+        void Reset()
+        {
+            cells_.Reset();
+        }
+
+    private:
+        detail::StripedCells<std::size_t, Stripes> cells_{0};
+    };
+
+    // Up/down counterpart of StripedCounter for things like queue depth or requests in flight. A single stripe
+    // may go negative, the sum is what counts.
+    template <std::size_t Stripes = 16>
+    class StripedGauge
+    {
+    public:
+        void Add(long long delta)
+        {
+            cells_.Local().fetch_add(delta, std::memory_order_relaxed);
+        }
+
+        void Increment()
+        {
+            Add(1);
+        }
+
+        void Decrement()
+        {
+            Add(-1);
+        }
+
+        long long Load() const
+        {
+            return cells_.Fold(std::plus<>{});
+        }
+
+        void Reset()
+        {
+            cells_.Reset();
+        }
+
+    private:
+        detail::StripedCells<long long, Stripes> cells_{0};
+    };
+
+    // Running maximum (or minimum with std::less) of the recorded values. Record() only writes when the value
+    // beats its thread's stripe, so once the extremum has settled it is a plain load. Load() returns Identity
+    // when nothing has been recorded since construction or the last Reset().
+    template <class T, class Compare, T Identity, std::size_t Stripes = 16>
+    class StripedExtremum
+    {
+    public:
+        void Record(T value)
+        {
+            auto& cell = cells_.Local();
+            auto current = cell.load(std::memory_order_relaxed);
+            while (Compare{}(value, current) && !cell.compare_exchange_weak(current, value, std::memory_order_relaxed))
+            {
+            }
+        }
+
+        T Load() const
+        {
+            return cells_.Fold([](T lhs, T rhs) { return Compare{}(rhs, lhs) ? rhs : lhs; });
+        }
+
+        void Reset()
+        {
+            cells_.Reset();
+        }
+
+    private:
+        detail::StripedCells<T, Stripes> cells_{Identity};
+    };
+
+    template <class T, std::size_t Stripes = 16>
+    using StripedMax = StripedExtremum<T, std::greater<>, std::numeric_limits<T>::lowest(), Stripes>;
+
+    template <class T, std::size_t Stripes = 16>
+    using StripedMin = StripedExtremum<T, std::less<>, std::numeric_limits<T>::max(), Stripes>;
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+
+namespace lockfree
+{
+    // Hands out small dense indexes to threads for per-thread slots in wait-free structures. An index is
+    // taken on the first call from a thread and given back when that thread exits.
+    template <std::size_t MaxThreads>
+    class ThreadRegistry
+    {
+    public:
+        // Throws std::length_error when more than MaxThreads threads hold an index at once.
+        static std::size_t Index()
+        {
+            thread_local Slot slot;
+            return slot.index;
+        }
+
+    private:
+        struct Slot
+        {
+            Slot()
+                : index(Acquire())
+            {
+            }
+
+            ~Slot()
+            {
+                used_[index].store(false, std::memory_order_release);
+            }
+
+            const std::size_t index;
+        };
+
+        static std::size_t Acquire()
+        {
+            for (std::size_t i = 0; i < MaxThreads; ++i)
+            {
+                bool expected = false;
+                if (!used_[i].load(std::memory_order_relaxed) && used_[i].compare_exchange_strong(expected, true, std::memory_order_acquire))
+                {
+                    return i;
+                }
+            }
+
+            throw std::length_error("Too many threads!");
+        }
+
+    private:
+        static inline std::array<std::atomic<bool>, MaxThreads> used_{};
+    };
+}
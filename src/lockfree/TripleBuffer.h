@@ -0,0 +1,95 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include <Alignment.h>
+
+namespace lockfree
+{
+    // Wait-free latest-value slot for one writer and one reader. The writer fills a back buffer and swaps it
+    // with the middle one; the reader swaps the middle buffer with its front one only when it holds something
+    // newer. Intermediate values the reader never got to are simply overwritten, so a slow reader never
+    // builds up a backlog and always sees the newest complete value.
+    template <class T>
+    class TripleBuffer
+    {
+        static constexpr uint8_t kIndexMask = 0b011;
+        static constexpr uint8_t kFresh = 0b100;
+
+        struct alignas(alignment::hardware_destructive_interference_size) Slot
+        {
+            T value;
+        };
+
+    public:
+        TripleBuffer() requires std::is_default_constructible_v<T> = default;
+
+        explicit TripleBuffer(const T& initial)
+            : slots_{Slot{initial}, Slot{initial}, Slot{initial}}
+        {
+        }
+
+        // Writer side. Either Write() a whole value, or fill WriteBuffer() in place and Publish() it.
+        void Write(const T& value)
+        {
+            WriteBuffer() = value;
+            Publish();
+        }
+
+        void Write(T&& value)
+        {
+            WriteBuffer() = std::move(value);
+            Publish();
+        }
+
+        // Holds whatever the writer left there two publications ago.
+        T& WriteBuffer()
+        {
+            return slots_[back_].value;
+        }
+
+        void Publish()
+        {
+            back_ = middle_.exchange(back_ | kFresh, std::memory_order_acq_rel) & kIndexMask;
+        }
+
+        // Reader side. Returns false when nothing was published since the last Update().
+        bool Update()
+        {
+            if (!(middle_.load(std::memory_order_relaxed) & kFresh))
+            {
+                return false;
+            }
+
+            front_ = middle_.exchange(front_, std::memory_order_acq_rel) & kIndexMask;
+            return true;
+        }
+
+        const T& Read() const
+        {
+            return slots_[front_].value;
+        }
+
+        // Moves the newest value out, so a following Read() sees a moved-from value.
+        std::optional<T> Pop()
+        {
+            if (!Update())
+            {
+                return std::nullopt;
+            }
+
+            return std::move(slots_[front_].value);
+        }
+
+    private:
+        std::array<Slot, 3> slots_{};
+        alignas(alignment::hardware_destructive_interference_size) std::atomic<uint8_t> middle_{1};
+        alignas(alignment::hardware_destructive_interference_size) uint8_t back_ = 2;
+        alignas(alignment::hardware_destructive_interference_size) uint8_t front_ = 0;
+    };
+}
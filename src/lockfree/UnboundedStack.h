@@ -4,10 +4,12 @@
 #include <optional>
 
 #include "../utils/Packing.h"
+#include <Backoff.h>
 
 namespace lockfree
 {
-    template <class T>
+    // Backoff is one of the policies from Backoff.h, applied after every lost CAS.
+    template <class T, class Backoff = backoff::Default>
     class UnboundedStack
     {
         struct Node
@@ -47,32 +49,39 @@ namespace lockfree
         std::atomic<uint64_t> m_head{};
     };
 
-    template<class T>
-    void UnboundedStack<T>::Push(T value)
+    template<class T, class Backoff>
+    void UnboundedStack<T, Backoff>::Push(T value)
     {
         auto* newNode = new Node{ .value = std::move(value) };
 
         uint64_t oldHeadData;
         TaggedPtr newHead { .ptr = newNode };
 
-        do
+        Backoff backoff;
+        while (true)
         {
             oldHeadData = m_head.load(std::memory_order::acquire);
             auto oldHead = Unpack(oldHeadData);
             newNode->next = oldHead.ptr;
             newHead.tag = oldHead.tag + 1;
+            if (m_head.compare_exchange_weak(oldHeadData, Pack(newHead), std::memory_order::release, std::memory_order::relaxed))
+            {
+                break;
+            }
+
+            backoff.Wait();
         }
-        while (!m_head.compare_exchange_weak(oldHeadData, Pack(newHead), std::memory_order::release, std::memory_order::relaxed));
     }
 
-    template<class T>
-    std::optional<T> UnboundedStack<T>::Pop()
+    template<class T, class Backoff>
+    std::optional<T> UnboundedStack<T, Backoff>::Pop()
     {
         uint64_t oldHeadData;
         TaggedPtr oldHead;
         TaggedPtr newHead;
 
-        do
+        Backoff backoff;
+        while (true)
         {
             oldHeadData = m_head.load(std::memory_order::acquire);
             oldHead = Unpack(oldHeadData);
@@ -83,21 +92,27 @@ namespace lockfree
 
             newHead.ptr = oldHead.ptr->next;
             newHead.tag = oldHead.tag + 1;
-        } while (m_head.compare_exchange_weak(oldHeadData, Pack(newHead), std::memory_order::release, std::memory_order::relaxed));
+            if (m_head.compare_exchange_weak(oldHeadData, Pack(newHead), std::memory_order::release, std::memory_order::relaxed))
+            {
+                break;
+            }
+
+            backoff.Wait();
+        }
 
         auto result = std::move(oldHead.ptr->value);
         delete oldHead.ptr;
-        return std::move(result);
+        return result;
     }
 
-    template<class T>
-    uint64_t UnboundedStack<T>::Pack(TaggedPtr node)
+    template<class T, class Backoff>
+    uint64_t UnboundedStack<T, Backoff>::Pack(TaggedPtr node)
     {
        return packing::PackPointerWithData(node.ptr, node.tag);
     }
 
-    template<class T>
-    typename UnboundedStack<T>::TaggedPtr UnboundedStack<T>::Unpack(uint64_t data)
+    template<class T, class Backoff>
+    typename UnboundedStack<T, Backoff>::TaggedPtr UnboundedStack<T, Backoff>::Unpack(uint64_t data)
     {
         return {
             .ptr = packing::UnpackPointer<Node>(data),
@@ -0,0 +1,287 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <optional>
+#include <unordered_set>
+#include <utility>
+
+#include <Alignment.h>
+#include <HazardPointers.h>
+#include <ThreadRegistry.h>
+
+namespace lockfree
+{
+    // Wait-free unbounded MPMC queue: the Turn queue by Correia and Ramalhete, a Kogan-Petrank style queue
+    // whose helping finishes in O(MaxThreads) steps and whose hazard pointer reclamation scans all slots only
+    // once every few hundred Pop() calls, so every operation stays bounded. Enqueuers publish their
+    // node and every operation helps pending requests in turn order, so no thread can be starved by the others.
+    // At most MaxThreads threads may use queues with the same MaxThreads at once (see ThreadRegistry).
+    template <class T, std::size_t MaxThreads = 64>
+    class WaitFreeQueue
+    {
+        static constexpr int kNone = -1;
+        static constexpr int kThreads = static_cast<int>(MaxThreads);
+
+        static constexpr std::size_t kHazardTail = 0;
+        static constexpr std::size_t kHazardHead = 0;
+        static constexpr std::size_t kHazardNext = 1;
+        static constexpr std::size_t kHazardDequeue = 2;
+
+        struct Node
+        {
+            std::optional<T> value;
+            const int enqueuer;
+            std::atomic<int> dequeuer{kNone};
+            std::atomic<Node*> next{nullptr};
+        };
+
+        template <class U>
+        struct alignas(alignment::hardware_destructive_interference_size) Padded
+        {
+            std::atomic<U> value;
+        };
+
+    public:
+        WaitFreeQueue()
+            : sentinel_(new Node{.value = std::nullopt, .enqueuer = 0})
+        {
+            head_.store(sentinel_, std::memory_order_relaxed);
+            tail_.store(sentinel_, std::memory_order_relaxed);
+            for (std::size_t i = 0; i < MaxThreads; ++i)
+            {
+                enqueuers_[i].value.store(nullptr, std::memory_order_relaxed);
+                // A request is open while both slots point to the same node.
+                dequeueSelf_[i].value.store(new Node{.value = std::nullopt, .enqueuer = 0}, std::memory_order_relaxed);
+                dequeueHelp_[i].value.store(new Node{.value = std::nullopt, .enqueuer = 0}, std::memory_order_relaxed);
+            }
+        }
+
+        WaitFreeQueue(const WaitFreeQueue&) = delete;
+        WaitFreeQueue& operator=(const WaitFreeQueue&) = delete;
+
+        ~WaitFreeQueue()
+        {
+            std::unordered_set<Node*> nodes{sentinel_};
+            for (auto* node = head_.load(); node; node = node->next.load())
+            {
+                nodes.insert(node);
+            }
+            for (std::size_t i = 0; i < MaxThreads; ++i)
+            {
+                nodes.insert(dequeueSelf_[i].value.load());
+                nodes.insert(dequeueHelp_[i].value.load());
+            }
+
+            for (auto* node : nodes)
+            {
+                delete node;
+            }
+        }
+
+        void Push(T value)
+        {
+            const auto self = Self();
+            auto* node = new Node{.value = std::move(value), .enqueuer = self};
+            enqueuers_[self].value.store(node);
+
+            for (int i = 0; i < kThreads; ++i)
+            {
+                if (!enqueuers_[self].value.load())
+                {
+                    // Someone else linked our node and moved the tail past it.
+                    hazards_.Clear(self);
+                    return;
+                }
+
+                auto* tail = hazards_.Protect(kHazardTail, tail_.load(), self);
+                if (tail != tail_.load())
+                {
+                    continue;
+                }
+
+                // The node at the tail is linked, so its request is done.
+                if (enqueuers_[tail->enqueuer].value.load() == tail)
+                {
+                    auto* expected = tail;
+                    enqueuers_[tail->enqueuer].value.compare_exchange_strong(expected, nullptr);
+                }
+
+                // Link the next pending node in turn order after the enqueuer of the tail.
+                for (int j = 1; j <= kThreads; ++j)
+                {
+                    auto* pending = enqueuers_[(tail->enqueuer + j) % kThreads].value.load();
+                    if (!pending)
+                    {
+                        continue;
+                    }
+
+                    Node* expected = nullptr;
+                    tail->next.compare_exchange_strong(expected, pending);
+                    break;
+                }
+
+                if (auto* next = tail->next.load())
+                {
+                    tail_.compare_exchange_strong(tail, next);
+                }
+            }
+
+            enqueuers_[self].value.store(nullptr, std::memory_order_release);
+            hazards_.Clear(self);
+        }
+
+        std::optional<T> Pop()
+        {
+            const auto self = Self();
+            auto* previous = dequeueSelf_[self].value.load();
+            auto* request = dequeueHelp_[self].value.load();
+            dequeueSelf_[self].value.store(request);
+
+            for (int i = 0; i < kThreads; ++i)
+            {
+                if (dequeueHelp_[self].value.load() != request)
+                {
+                    break;
+                }
+
+                auto* head = hazards_.Protect(kHazardHead, head_.load(), self);
+                if (head != head_.load())
+                {
+                    continue;
+                }
+
+                if (head == tail_.load())
+                {
+                    // Looks empty: withdraw the request, unless a helper has served it in the meantime.
+                    dequeueSelf_[self].value.store(previous);
+                    GiveUp(request, self);
+                    if (dequeueHelp_[self].value.load() != request)
+                    {
+                        dequeueSelf_[self].value.store(request, std::memory_order_relaxed);
+                        break;
+                    }
+
+                    hazards_.Clear(self);
+                    return std::nullopt;
+                }
+
+                auto* next = hazards_.Protect(kHazardNext, head->next.load(), self);
+                if (head != head_.load())
+                {
+                    continue;
+                }
+
+                if (AssignNext(head, next) != kNone)
+                {
+                    HandOverAndAdvance(head, next, self);
+                }
+            }
+
+            auto* node = dequeueHelp_[self].value.load();
+            auto* head = hazards_.Protect(kHazardHead, head_.load(), self);
+            if (head == head_.load() && node == head->next.load())
+            {
+                head_.compare_exchange_strong(head, node);
+            }
+
+            hazards_.Clear(self);
+            hazards_.Retire(previous, self);
+            return std::move(node->value);
+        }
+
+        // Snapshot, exact only when no Push or Pop is running.
+        bool Empty() const
+        {
+            return head_.load() == tail_.load();
+        }
+
+    private:
+        static int Self()
+        {
+            return static_cast<int>(ThreadRegistry<MaxThreads>::Index());
+        }
+
+        // Picks the dequeuer that gets `next`: the first open request after the dequeuer of `head` in turn order.
+        int AssignNext(Node* head, Node* next)
+        {
+            const auto turn = head->dequeuer.load();
+            for (int i = turn + 1; i < turn + kThreads + 1; ++i)
+            {
+                const auto candidate = (i % kThreads + kThreads) % kThreads;
+                if (dequeueSelf_[candidate].value.load() != dequeueHelp_[candidate].value.load())
+                {
+                    continue;
+                }
+
+                if (next->dequeuer.load() == kNone)
+                {
+                    auto expected = kNone;
+                    next->dequeuer.compare_exchange_strong(expected, candidate);
+                }
+                break;
+            }
+
+            return next->dequeuer.load();
+        }
+
+        // Gives `next` to the dequeuer it was assigned to and moves the head onto it.
+        void HandOverAndAdvance(Node* head, Node* next, int self)
+        {
+            const auto dequeuer = next->dequeuer.load();
+            if (dequeuer == self)
+            {
+                dequeueHelp_[dequeuer].value.store(next, std::memory_order_release);
+            }
+            else
+            {
+                auto* help = hazards_.Protect(kHazardDequeue, dequeueHelp_[dequeuer].value.load(), self);
+                if (help != next && head == head_.load())
+                {
+                    dequeueHelp_[dequeuer].value.compare_exchange_strong(help, next);
+                }
+            }
+
+            head_.compare_exchange_strong(head, next);
+        }
+
+        void GiveUp(Node* request, int self)
+        {
+            auto* head = head_.load();
+            if (dequeueHelp_[self].value.load() != request || head == tail_.load())
+            {
+                return;
+            }
+
+            hazards_.Protect(kHazardHead, head, self);
+            if (head != head_.load())
+            {
+                return;
+            }
+
+            auto* next = hazards_.Protect(kHazardNext, head->next.load(), self);
+            if (head != head_.load())
+            {
+                return;
+            }
+
+            if (AssignNext(head, next) == kNone)
+            {
+                auto expected = kNone;
+                next->dequeuer.compare_exchange_strong(expected, self);
+            }
+
+            HandOverAndAdvance(head, next, self);
+        }
+
+    private:
+        alignas(alignment::hardware_destructive_interference_size) std::atomic<Node*> head_;
+        alignas(alignment::hardware_destructive_interference_size) std::atomic<Node*> tail_;
+        Node* const sentinel_;
+        std::array<Padded<Node*>, MaxThreads> enqueuers_;
+        std::array<Padded<Node*>, MaxThreads> dequeueSelf_;
+        std::array<Padded<Node*>, MaxThreads> dequeueHelp_;
+        HazardPointers<Node, MaxThreads, 3> hazards_;
+    };
+}
@@ -0,0 +1,195 @@
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+namespace logging
+{
+    // Character strings are copied into the record, so the caller's buffer may go away right after the call.
+    template <class T>
+    concept InlineString = std::is_same_v<T, const char*> || std::is_same_v<T, char*> || std::is_same_v<T, std::string_view>;
+
+    // Types a log call may take: copied into the record as raw bytes and only formatted by the background
+    // thread. Strings share whatever room the other arguments leave and are truncated to it; any other
+    // pointer is logged as its address.
+    template <class T>
+    concept Loggable = std::is_arithmetic_v<T> || std::is_enum_v<T> || std::is_pointer_v<T> || InlineString<T>;
+
+    namespace detail
+    {
+        template <class T>
+        void Append(std::string& out, T value)
+        {
+            if constexpr (std::is_same_v<T, bool>)
+            {
+                out += value ? "true" : "false";
+            }
+            else if constexpr (std::is_same_v<T, char>)
+            {
+                out += value;
+            }
+            else if constexpr (std::is_same_v<T, const char*> || std::is_same_v<T, char*>)
+            {
+                out += value ? value : "(null)";
+            }
+            else if constexpr (std::is_same_v<T, std::string_view>)
+            {
+                out += value;
+            }
+            else if constexpr (std::is_enum_v<T>)
+            {
+                Append(out, static_cast<std::underlying_type_t<T>>(value));
+            }
+            else if constexpr (std::is_pointer_v<T>)
+            {
+                out += "0x";
+                char buffer[2 * sizeof(uintptr_t)];
+                const auto result = std::to_chars(buffer, buffer + sizeof(buffer), reinterpret_cast<uintptr_t>(value), 16);
+                out.append(buffer, result.ptr);
+            }
+            else
+            {
+                char buffer[64];
+                const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+                out.append(buffer, result.ptr);
+            }
+        }
+
+        // Every "{}" takes the next argument, "{{" and "}}" are literal braces. Missing arguments leave the
+        // placeholder as is, extra ones are ignored.
+        template <class... Args>
+        void Format(std::string& out, std::string_view format, const Args&... args)
+        {
+            std::size_t next = 0;
+            auto appendNext = [&out, &next, &args...]()
+            {
+                [[maybe_unused]] std::size_t index = 0;
+                static_cast<void>(((index++ == next ? (Append(out, args), true) : false) || ...));
+                return next++ < sizeof...(Args);
+            };
+
+            for (std::size_t i = 0; i < format.size(); ++i)
+            {
+                const auto c = format[i];
+                if (c == '{' && i + 1 < format.size() && format[i + 1] == '}')
+                {
+                    if (!appendNext())
+                    {
+                        out += "{}";
+                    }
+                    ++i;
+                }
+                else if ((c == '{' || c == '}') && i + 1 < format.size() && format[i + 1] == c)
+                {
+                    out += c;
+                    ++i;
+                }
+                else
+                {
+                    out += c;
+                }
+            }
+        }
+
+        // A packed string is a length byte and its characters; this length marks a null pointer.
+        inline constexpr std::size_t kNullString = UINT8_MAX;
+
+        // Strings come back as views into the record.
+        template <class T>
+        using Unpacked = std::conditional_t<InlineString<T>, std::string_view, T>;
+
+        // The least room the arguments need: an empty string takes just its length byte.
+        template <class... Args>
+        constexpr std::size_t PackedSize()
+        {
+            return (std::size_t{0} + ... + (InlineString<Args> ? 1 : sizeof(Args)));
+        }
+
+        // Fixed-size arguments first, then the strings in whatever is left of the `size` bytes.
+        template <class... Args>
+        void Pack(std::byte* bytes, std::size_t size, const Args&... args)
+        {
+            const auto* end = bytes + size;
+            [[maybe_unused]] auto packFixed = [&bytes]<class T>(const T& arg)
+            {
+                if constexpr (!InlineString<T>)
+                {
+                    std::memcpy(bytes, &arg, sizeof(T));
+                    bytes += sizeof(T);
+                }
+            };
+
+            std::size_t strings = (std::size_t{0} + ... + (InlineString<Args> ? 1 : 0));
+            [[maybe_unused]] auto packString = [&bytes, end, &strings]<class T>(const T& arg)
+            {
+                if constexpr (InlineString<T>)
+                {
+                    --strings;
+                    if constexpr (std::is_pointer_v<T>)
+                    {
+                        if (!arg)
+                        {
+                            *bytes++ = std::byte{kNullString};
+                            return;
+                        }
+                    }
+
+                    // Keep a length byte for every string still to come.
+                    const std::string_view view(arg);
+                    const auto room = static_cast<std::size_t>(end - bytes) - 1 - strings;
+                    const auto length = std::min({view.size(), room, kNullString - 1});
+                    *bytes++ = static_cast<std::byte>(length);
+                    std::memcpy(bytes, view.data(), length);
+                    bytes += length;
+                }
+            };
+
+            (packFixed(args), ...);
+            (packString(args), ...);
+        }
+
+        template <class... Args>
+        std::tuple<Unpacked<Args>...> Unpack(const std::byte* bytes)
+        {
+            std::tuple<Unpacked<Args>...> args;
+            std::apply([&bytes](auto&... arg)
+            {
+                [[maybe_unused]] auto unpackFixed = [&bytes]<class T>(T& value)
+                {
+                    if constexpr (!std::is_same_v<T, std::string_view>)
+                    {
+                        std::memcpy(&value, bytes, sizeof(T));
+                        bytes += sizeof(T);
+                    }
+                };
+
+                [[maybe_unused]] auto unpackString = [&bytes]<class T>(T& value)
+                {
+                    if constexpr (std::is_same_v<T, std::string_view>)
+                    {
+                        const auto length = std::to_integer<std::size_t>(*bytes++);
+                        if (length == kNullString)
+                        {
+                            value = "(null)";
+                            return;
+                        }
+
+                        value = std::string_view(reinterpret_cast<const char*>(bytes), length);
+                        bytes += length;
+                    }
+                };
+
+                (unpackFixed(arg), ...);
+                (unpackString(arg), ...);
+            }, args);
+            return args;
+        }
+    }
+}
@@ -0,0 +1,429 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <Format.h>
+#include <OverwritingRingBuffer.h>
+#include <SPSCRingBuffer.h>
+
+namespace logging
+{
+    enum class Level : uint8_t
+    {
+        Debug,
+        Info,
+        Warning,
+        Error,
+    };
+
+    // What a log call does when its thread's ring is full.
+    enum class FullPolicy
+    {
+        // Loses the new record and counts it in Dropped().
+        Drop,
+        // Yields until the background thread makes room.
+        Block,
+        // Loses the oldest unread record instead, counted in Dropped() as well.
+        Overwrite,
+    };
+
+    // Everything about a log statement that is known at compile time. Records only point at it.
+    struct Site
+    {
+        Level level;
+        const char* format;
+        const char* file;
+        int line;
+    };
+
+    struct Options
+    {
+        std::filesystem::path path;
+        // How long the background thread sleeps when every ring was empty.
+        std::chrono::microseconds idle{100};
+        // Formatted output is written with one syscall per this many bytes, or when the rings run dry.
+        std::size_t batchBytes = 64 * 1024;
+    };
+
+    namespace detail
+    {
+        inline constexpr std::size_t kRecordSize = 128;
+
+        struct Record;
+        using Formatter = void (*)(std::string&, const Site&, const Record&);
+
+        // Fixed-size binary record: the site, the formatter instantiated for the argument types, the time and
+        // the arguments' raw bytes.
+        struct Record
+        {
+            const Site* site;
+            Formatter formatter;
+            int64_t timestamp;
+            std::array<std::byte, kRecordSize - sizeof(const Site*) - sizeof(Formatter) - sizeof(int64_t)> args;
+        };
+
+        static_assert(sizeof(Record) == kRecordSize);
+
+        template <class... Args>
+        void FormatRecord(std::string& out, const Site& site, const Record& record)
+        {
+            std::apply([&out, &site](const auto&... args) { Format(out, site.format, args...); }, Unpack<Args...>(record.args.data()));
+        }
+
+        inline uint64_t NextLoggerId()
+        {
+            static std::atomic<uint64_t> id{0};
+            return id.fetch_add(1, std::memory_order_relaxed) + 1;
+        }
+    }
+
+    // Asynchronous logger. Every thread that logs gets its own ring of binary records, so a log call costs a
+    // clock read and a copy of its arguments into a lock-free ring, with no formatting, no allocation and no
+    // syscall. A background thread drains all rings, formats the records and writes the text in batches.
+    //
+    // Rings are created on a thread's first log call and handed to a new thread once their owner exits; the
+    // records of one thread stay in order, while different threads interleave per drain pass.
+    template <FullPolicy Policy = FullPolicy::Drop, std::size_t RingCapacity = 4096>
+    class Logger
+    {
+        using Record = detail::Record;
+        using Ring = std::conditional_t<Policy == FullPolicy::Overwrite,
+            lockfree::OverwritingRingBuffer<Record, RingCapacity>,
+            lockfree::SPSCRingBuffer<Record, RingCapacity>>;
+
+        struct ThreadRing
+        {
+            Ring ring;
+            std::atomic<uint64_t> dropped{0};
+            std::atomic<bool> owned{true};
+            std::size_t index = 0;
+        };
+
+        struct Registration
+        {
+            uint64_t id;
+            // Valid while the logger is, which any call on it guarantees.
+            ThreadRing* ring;
+            std::weak_ptr<ThreadRing> owner;
+        };
+
+        // Rings of the current thread, per logger. Only the logger owns them, so a destroyed logger frees its
+        // rings right away; the destructor runs at thread exit and releases those still alive.
+        struct Registrations
+        {
+            ~Registrations()
+            {
+                for (auto& registration : rings)
+                {
+                    if (const auto ring = registration.owner.lock())
+                    {
+                        ring->owned.store(false, std::memory_order_release);
+                    }
+                }
+            }
+
+            std::vector<Registration> rings;
+        };
+
+    public:
+        explicit Logger(Options options)
+            : options_(std::move(options))
+            , fd_(::open(options_.path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644))
+        {
+            if (fd_ < 0)
+            {
+                throw std::system_error(errno, std::generic_category(), "Cannot open " + options_.path.string());
+            }
+
+            worker_ = std::jthread([this](std::stop_token stop) { Run(stop); });
+        }
+
+        Logger(const Logger&) = delete;
+        Logger& operator=(const Logger&) = delete;
+
+        // Writes out everything logged before.
+        ~Logger()
+        {
+            worker_.request_stop();
+            worker_.join();
+            ::close(fd_);
+        }
+
+        // Use the LOGGING_* macros, which keep a static Site per statement.
+        template <Loggable... Args>
+        void Log(const Site& site, Args... args)
+        {
+            static_assert(detail::PackedSize<Args...>() <= sizeof(Record::args), "Too many log arguments!");
+
+            Record record;
+            record.site = &site;
+            record.formatter = &detail::FormatRecord<Args...>;
+            record.timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+            detail::Pack(record.args.data(), record.args.size(), args...);
+
+            auto& local = Local();
+            if constexpr (Policy == FullPolicy::Overwrite)
+            {
+                local.ring.Push(record);
+            }
+            else if constexpr (Policy == FullPolicy::Block)
+            {
+                while (!local.ring.Push(record))
+                {
+                    std::this_thread::yield();
+                }
+            }
+            else if (!local.ring.Push(record))
+            {
+                local.dropped.store(local.dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            }
+        }
+
+        // Blocks until everything this thread logged before the call is written; takes up to Options::idle.
+        void Flush()
+        {
+            const auto ticket = flush_requested_.fetch_add(1, std::memory_order_acq_rel) + 1;
+            auto flushed = flushed_.load(std::memory_order_acquire);
+            while (flushed < ticket)
+            {
+                flushed_.wait(flushed, std::memory_order_acquire);
+                flushed = flushed_.load(std::memory_order_acquire);
+            }
+        }
+
+        uint64_t Dropped() const
+        {
+            std::lock_guard guard(mutex_);
+            uint64_t dropped = 0;
+            for (const auto& ring : rings_)
+            {
+                if constexpr (Policy == FullPolicy::Overwrite)
+                {
+                    dropped += ring->ring.Overwritten();
+                }
+                else
+                {
+                    dropped += ring->dropped.load(std::memory_order_relaxed);
+                }
+            }
+            return dropped;
+        }
+
+    private:
+        ThreadRing& Local()
+        {
+            thread_local Registrations registrations;
+            auto& rings = registrations.rings;
+            if (!rings.empty() && rings.back().id == id_) [[likely]]
+            {
+                return *rings.back().ring;
+            }
+
+            const auto found = std::find_if(rings.begin(), rings.end(), [this](const auto& entry) { return entry.id == id_; });
+            if (found != rings.end())
+            {
+                std::iter_swap(found, rings.end() - 1);
+                return *rings.back().ring;
+            }
+
+            std::erase_if(rings, [](const auto& entry) { return entry.owner.expired(); });
+            auto ring = Acquire();
+            rings.push_back(Registration{id_, ring.get(), ring});
+            return *ring;
+        }
+
+        std::shared_ptr<ThreadRing> Acquire()
+        {
+            std::lock_guard guard(mutex_);
+            for (const auto& ring : rings_)
+            {
+                bool owned = false;
+                if (ring->owned.compare_exchange_strong(owned, true, std::memory_order_acquire))
+                {
+                    return ring;
+                }
+            }
+
+            // Not make_shared: the registrations' weak references would keep the ring's memory alive.
+            std::shared_ptr<ThreadRing> ring(new ThreadRing);
+            ring->index = rings_.size();
+            rings_.push_back(ring);
+            rings_version_.fetch_add(1, std::memory_order_release);
+            return ring;
+        }
+
+        void Run(std::stop_token stop)
+        {
+            std::vector<std::shared_ptr<ThreadRing>> rings;
+            uint64_t version = 0;
+
+            while (true)
+            {
+                const auto requested = flush_requested_.load(std::memory_order_acquire);
+                const auto stopping = stop.stop_requested();
+
+                if (const auto current = rings_version_.load(std::memory_order_acquire); current != version)
+                {
+                    std::lock_guard guard(mutex_);
+                    rings = rings_;
+                    version = current;
+                }
+
+                std::size_t drained = 0;
+                for (const auto& ring : rings)
+                {
+                    drained += Drain(*ring);
+                }
+
+                // A pass takes up to a full ring from every ring, so it covered everything logged before the
+                // request even when other threads kept logging meanwhile.
+                if (requested != flushed_.load(std::memory_order_relaxed))
+                {
+                    WriteOut();
+                    flushed_.store(requested, std::memory_order_release);
+                    flushed_.notify_all();
+                }
+
+                if (drained > 0)
+                {
+                    continue;
+                }
+
+                WriteOut();
+                if (stopping)
+                {
+                    return;
+                }
+
+                std::this_thread::sleep_for(options_.idle);
+            }
+        }
+
+        // Takes at most one ring's worth of records, so one busy thread cannot starve the others.
+        std::size_t Drain(ThreadRing& ring)
+        {
+            std::size_t drained = 0;
+            for (; drained < RingCapacity; ++drained)
+            {
+                auto record = ring.ring.Pop();
+                if (!record)
+                {
+                    break;
+                }
+
+                if constexpr (Policy == FullPolicy::Overwrite)
+                {
+                    Append(record->value, ring.index);
+                }
+                else
+                {
+                    Append(*record, ring.index);
+                }
+
+                if (buffer_.size() >= options_.batchBytes)
+                {
+                    WriteOut();
+                }
+            }
+            return drained;
+        }
+
+        // "2026-01-31 12:34:56.123456789 INFO [T0] message"
+        void Append(const Record& record, std::size_t thread)
+        {
+            static constexpr std::array<const char*, 4> kLevels = {"DEBUG", "INFO", "WARNING", "ERROR"};
+
+            const auto seconds = record.timestamp / 1'000'000'000;
+            if (seconds != cached_second_)
+            {
+                const auto time = static_cast<std::time_t>(seconds);
+                std::tm local{};
+                localtime_r(&time, &local);
+                char text[32];
+                cached_time_.assign(text, std::strftime(text, sizeof(text), "%Y-%m-%d %H:%M:%S.", &local));
+                cached_second_ = seconds;
+            }
+
+            buffer_ += cached_time_;
+            const auto nanoseconds = std::to_string(record.timestamp % 1'000'000'000);
+            buffer_.append(9 - nanoseconds.size(), '0');
+            buffer_ += nanoseconds;
+            buffer_ += ' ';
+            buffer_ += kLevels[static_cast<std::size_t>(record.site->level)];
+            buffer_ += " [T";
+            buffer_ += std::to_string(thread);
+            buffer_ += "] ";
+            record.formatter(buffer_, *record.site, record);
+            buffer_ += '\n';
+        }
+
+        void WriteOut()
+        {
+            std::size_t written = 0;
+            while (written < buffer_.size())
+            {
+                const auto result = ::write(fd_, buffer_.data() + written, buffer_.size() - written);
+                if (result < 0)
+                {
+                    if (errno == EINTR)
+                    {
+                        continue;
+                    }
+                    // Nowhere left to report to; the records are lost.
+                    break;
+                }
+                written += static_cast<std::size_t>(result);
+            }
+            buffer_.clear();
+        }
+
+    private:
+        const Options options_;
+        const uint64_t id_ = detail::NextLoggerId();
+        const int fd_;
+
+        mutable std::mutex mutex_;
+        std::vector<std::shared_ptr<ThreadRing>> rings_;
+        std::atomic<uint64_t> rings_version_{0};
+
+        std::atomic<uint64_t> flush_requested_{0};
+        std::atomic<uint64_t> flushed_{0};
+
+        // Background thread only.
+        std::string buffer_;
+        std::string cached_time_;
+        int64_t cached_second_ = -1;
+
+        std::jthread worker_;
+    };
+}
+
+#define LOGGING_LOG(logger, level, format, ...) \
+    do \
+    { \
+        static constexpr ::logging::Site loggingSite{level, format, __FILE__, __LINE__}; \
+        (logger).Log(loggingSite __VA_OPT__(,) __VA_ARGS__); \
+    } while (false)
+
+#define LOGGING_DEBUG(logger, format, ...) LOGGING_LOG(logger, ::logging::Level::Debug, format __VA_OPT__(,) __VA_ARGS__)
+#define LOGGING_INFO(logger, format, ...) LOGGING_LOG(logger, ::logging::Level::Info, format __VA_OPT__(,) __VA_ARGS__)
+#define LOGGING_WARNING(logger, format, ...) LOGGING_LOG(logger, ::logging::Level::Warning, format __VA_OPT__(,) __VA_ARGS__)
+#define LOGGING_ERROR(logger, format, ...) LOGGING_LOG(logger, ::logging::Level::Error, format __VA_OPT__(,) __VA_ARGS__)
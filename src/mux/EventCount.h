@@ -0,0 +1,59 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace mux
+{
+    // Parking word shared by any number of producers and consumers. A consumer announces itself with
+    // PrepareWait(), re-checks its condition and then either calls CancelWait() or Wait(). Producers call
+    // NotifyAll() after making the condition true; it is a single load while nobody is parked.
+    class EventCount
+    {
+        static constexpr uint64_t kWaiter = 1;
+        static constexpr uint64_t kEpoch = 1ull << 32;
+        static constexpr uint64_t kWaitersMask = kEpoch - 1;
+
+    public:
+        using Key = uint32_t;
+
+        Key PrepareWait()
+        {
+            const auto previous = state_.fetch_add(kWaiter, std::memory_order_seq_cst);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            return static_cast<Key>(previous >> 32);
+        }
+
+        void CancelWait()
+        {
+            state_.fetch_sub(kWaiter, std::memory_order_relaxed);
+        }
+
+        void Wait(Key key)
+        {
+            auto state = state_.load(std::memory_order_acquire);
+            while (static_cast<Key>(state >> 32) == key)
+            {
+                state_.wait(state, std::memory_order_acquire);
+                state = state_.load(std::memory_order_acquire);
+            }
+
+            state_.fetch_sub(kWaiter, std::memory_order_relaxed);
+        }
+
+        void NotifyAll()
+        {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if ((state_.load(std::memory_order_relaxed) & kWaitersMask) == 0)
+            {
+                return;
+            }
+
+            state_.fetch_add(kEpoch, std::memory_order_release);
+            state_.notify_all();
+        }
+
+    private:
+        std::atomic<uint64_t> state_{0};
+    };
+}
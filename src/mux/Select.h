@@ -0,0 +1,129 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+#include <EventCount.h>
+#include <Queue.h>
+
+namespace mux
+{
+    enum class Fairness
+    {
+        // Every call starts scanning right after the queue that delivered last time.
+        RoundRobin,
+        // Every call starts scanning from the first queue, so earlier queues always win.
+        Priority,
+    };
+
+    using queue::ElementOf;
+
+    // Pushes into a queue that is watched by a Selector and wakes the parked consumers.
+    template <queue::Queue Queue, class T>
+    bool PushAndNotify(Queue& queue, EventCount& event, T value)
+    {
+        if (!queue::TryPush(queue, std::move(value)))
+        {
+            return false;
+        }
+
+        event.NotifyAll();
+        return true;
+    }
+
+    // Waits on any of several queues from lockfree/ and blocking/ at once. The result is a variant whose
+    // index is the index of the queue the element came from. Producers must wake the selector through
+    // PushAndNotify() (or EventCount::NotifyAll() after their own Push) on the same EventCount.
+    template <queue::Queue... Queues>
+    class Selector
+    {
+        static_assert(sizeof...(Queues) > 0, "Selector needs at least one queue!");
+
+        static constexpr std::size_t kQueuesAmount = sizeof...(Queues);
+        static constexpr int kSpinTries = 64;
+
+    public:
+        using Result = std::variant<ElementOf<Queues>...>;
+
+        Selector(EventCount& event, Fairness fairness, Queues&... queues)
+            : event_(event)
+            , fairness_(fairness)
+            , queues_(queues...)
+        {
+        }
+
+        std::optional<Result> TrySelect()
+        {
+            const auto start = fairness_ == Fairness::RoundRobin ? next_ : 0;
+            for (std::size_t i = 0; i < kQueuesAmount; ++i)
+            {
+                auto index = start + i;
+                if (index >= kQueuesAmount)
+                {
+                    index -= kQueuesAmount;
+                }
+
+                if (auto result = TryPopAt(index, std::index_sequence_for<Queues...>{}))
+                {
+                    next_ = index + 1 == kQueuesAmount ? 0 : index + 1;
+                    return result;
+                }
+            }
+
+            return std::nullopt;
+        }
+
+        Result Select()
+        {
+            while (true)
+            {
+                for (int i = 0; i < kSpinTries; ++i)
+                {
+                    if (auto result = TrySelect())
+                    {
+                        return std::move(*result);
+                    }
+                }
+
+                const auto key = event_.PrepareWait();
+                if (auto result = TrySelect())
+                {
+                    event_.CancelWait();
+                    return std::move(*result);
+                }
+
+                event_.Wait(key);
+            }
+        }
+
+    private:
+        template <std::size_t... Indices>
+        std::optional<Result> TryPopAt(std::size_t index, std::index_sequence<Indices...>)
+        {
+            std::optional<Result> result;
+            ((index == Indices && (result = TryPop<Indices>(), true)) || ...);
+            return result;
+        }
+
+        template <std::size_t Index>
+        std::optional<Result> TryPop()
+        {
+            if (auto element = std::get<Index>(queues_).Pop())
+            {
+                return Result(std::in_place_index<Index>, std::move(*element));
+            }
+
+            return std::nullopt;
+        }
+
+    private:
+        EventCount& event_;
+        const Fairness fairness_;
+        std::tuple<Queues&...> queues_;
+        std::size_t next_ = 0;
+    };
+}
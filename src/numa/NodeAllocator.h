@@ -0,0 +1,134 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace numa
+{
+    // Lets the kernel place the memory on the node of the thread that touches it first.
+    constexpr int kFirstTouch = -1;
+
+    // Smallest page size, the granularity at which parts of one object can live on different nodes.
+    constexpr std::size_t kPageSize = 4096;
+
+    namespace detail
+    {
+        // From <numaif.h>, which would otherwise pull in libnuma.
+        constexpr int kMpolPreferred = 1;
+        constexpr unsigned kMpolMfMove = 1u << 1;
+
+        inline std::size_t PageRound(std::size_t bytes)
+        {
+            const auto page = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+            return (bytes + page - 1) / page * page;
+        }
+    }
+
+    // Prefers the given node for the pages of [address, address + bytes). The address must be page aligned.
+    // Fails on kernels without NUMA support, in which case the pages stay wherever they are first touched.
+    inline bool BindToNode(void* address, std::size_t bytes, int node)
+    {
+        if (node < 0)
+        {
+            return false;
+        }
+
+        constexpr auto kBitsPerWord = sizeof(unsigned long) * 8;
+        std::vector<unsigned long> mask(node / kBitsPerWord + 1);
+        mask[node / kBitsPerWord] = 1ul << (node % kBitsPerWord);
+
+        return syscall(SYS_mbind, address, detail::PageRound(bytes), detail::kMpolPreferred, mask.data(),
+            mask.size() * kBitsPerWord + 1, detail::kMpolMfMove) == 0;
+    }
+
+    // Page-granular allocator that binds what it hands out to one node. Meant for large slot arrays, not for
+    // node-based containers: every allocation takes at least one page.
+    template <class T>
+    class NodeAllocator
+    {
+    public:
+        using value_type = T;
+
+        explicit NodeAllocator(int node = kFirstTouch)
+            : node_(node)
+        {
+        }
+
+        template <class U>
+        NodeAllocator(const NodeAllocator<U>& other)
+            : node_(other.Node())
+        {
+        }
+
+        T* allocate(std::size_t n)
+        {
+            const auto bytes = detail::PageRound(n * sizeof(T));
+            void* memory = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (memory == MAP_FAILED)
+            {
+                throw std::bad_alloc();
+            }
+
+            BindToNode(memory, bytes, node_);
+            return static_cast<T*>(memory);
+        }
+
+        void deallocate(T* memory, std::size_t n)
+        {
+            munmap(memory, detail::PageRound(n * sizeof(T)));
+        }
+
+        int Node() const
+        {
+            return node_;
+        }
+
+        template <class U>
+        bool operator==(const NodeAllocator<U>& other) const
+        {
+            return node_ == other.Node();
+        }
+
+    private:
+        int node_;
+    };
+
+    template <class T>
+    struct NodeDeleter
+    {
+        NodeAllocator<T> allocator;
+
+        void operator()(T* object)
+        {
+            object->~T();
+            allocator.deallocate(object, 1);
+        }
+    };
+
+    template <class T>
+    using NodePtr = std::unique_ptr<T, NodeDeleter<T>>;
+
+    // Constructs an object on the given node, e.g. a ring buffer whose index words belong near their owner.
+    template <class T, class... Args>
+    NodePtr<T> MakeOnNode(int node, Args&&... args)
+    {
+        NodeAllocator<T> allocator(node);
+        T* memory = allocator.allocate(1);
+        try
+        {
+            return NodePtr<T>(new (memory) T(std::forward<Args>(args)...), NodeDeleter<T>{allocator});
+        }
+        catch (...)
+        {
+            allocator.deallocate(memory, 1);
+            throw;
+        }
+    }
+}
@@ -0,0 +1,175 @@
+#pragma once
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <pthread.h>
+#include <sched.h>
+
+namespace numa
+{
+    struct Cpu
+    {
+        int id = 0;
+        // Core id is only unique within its socket.
+        int core = 0;
+        int socket = 0;
+        int node = 0;
+    };
+
+    enum class Placement
+    {
+        // Two hardware threads of the same physical core.
+        SameCore,
+        // Two different cores of the same socket.
+        SameSocket,
+        // Cores of two different sockets or NUMA nodes.
+        CrossSocket,
+    };
+
+    namespace detail
+    {
+        inline const std::filesystem::path kCpuRoot = "/sys/devices/system/cpu";
+        inline const std::filesystem::path kNodeRoot = "/sys/devices/system/node";
+
+        inline std::optional<int> ReadInt(const std::filesystem::path& path)
+        {
+            std::ifstream file(path);
+            int value = 0;
+            if (file >> value)
+            {
+                return value;
+            }
+
+            return std::nullopt;
+        }
+
+        inline std::optional<int> NumberAfterPrefix(const std::string& name, const std::string& prefix)
+        {
+            if (name.size() <= prefix.size() || !name.starts_with(prefix))
+            {
+                return std::nullopt;
+            }
+
+            const auto digits = name.substr(prefix.size());
+            if (!std::all_of(digits.begin(), digits.end(), [](char c) { return c >= '0' && c <= '9'; }))
+            {
+                return std::nullopt;
+            }
+
+            return std::stoi(digits);
+        }
+
+        inline int NodeOfCpu(int cpu)
+        {
+            std::error_code error;
+            for (const auto& entry : std::filesystem::directory_iterator(kCpuRoot / ("cpu" + std::to_string(cpu)), error))
+            {
+                if (auto node = NumberAfterPrefix(entry.path().filename().string(), "node"))
+                {
+                    return *node;
+                }
+            }
+
+            return 0;
+        }
+    }
+
+    // CPUs this process may run on. Without sysfs every CPU is reported as its own core of socket 0 on node 0.
+    inline std::vector<Cpu> Cpus()
+    {
+        cpu_set_t allowed;
+        CPU_ZERO(&allowed);
+        if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0)
+        {
+            return {};
+        }
+
+        std::vector<Cpu> cpus;
+        for (int id = 0; id < CPU_SETSIZE; ++id)
+        {
+            if (!CPU_ISSET(id, &allowed))
+            {
+                continue;
+            }
+
+            const auto topology = detail::kCpuRoot / ("cpu" + std::to_string(id)) / "topology";
+            cpus.push_back({
+                .id = id,
+                .core = detail::ReadInt(topology / "core_id").value_or(id),
+                .socket = detail::ReadInt(topology / "physical_package_id").value_or(0),
+                .node = detail::NodeOfCpu(id),
+            });
+        }
+
+        return cpus;
+    }
+
+    inline int NodeCount()
+    {
+        int nodes = 0;
+        std::error_code error;
+        for (const auto& entry : std::filesystem::directory_iterator(detail::kNodeRoot, error))
+        {
+            if (detail::NumberAfterPrefix(entry.path().filename().string(), "node"))
+            {
+                ++nodes;
+            }
+        }
+
+        return std::max(nodes, 1);
+    }
+
+    inline int CurrentNode()
+    {
+        const auto cpu = sched_getcpu();
+        return cpu < 0 ? 0 : detail::NodeOfCpu(cpu);
+    }
+
+    inline bool PinThread(std::thread::native_handle_type thread, int cpu)
+    {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        return pthread_setaffinity_np(thread, sizeof(set), &set) == 0;
+    }
+
+    inline bool PinCurrentThread(int cpu)
+    {
+        return PinThread(pthread_self(), cpu);
+    }
+
+    // Finds a producer and consumer CPU with the requested placement, if this machine has one.
+    inline std::optional<std::pair<Cpu, Cpu>> FindPair(Placement placement, const std::vector<Cpu>& cpus = Cpus())
+    {
+        for (const auto& first : cpus)
+        {
+            for (const auto& second : cpus)
+            {
+                if (first.id == second.id)
+                {
+                    continue;
+                }
+
+                const bool sameSocket = first.socket == second.socket && first.node == second.node;
+                const bool sameCore = sameSocket && first.core == second.core;
+                const bool matches = placement == Placement::SameCore ? sameCore
+                    : placement == Placement::SameSocket ? sameSocket && !sameCore
+                    : !sameSocket;
+
+                if (matches)
+                {
+                    return std::make_pair(first, second);
+                }
+            }
+        }
+
+        return std::nullopt;
+    }
+}
@@ -0,0 +1,531 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <Alignment.h>
+#include <MPMCRingBuffer.h>
+#include <SPSCRingBuffer.h>
+
+namespace pipeline
+{
+    struct StageOptions
+    {
+        // Number of worker threads for the stage; any side with more than one thread gets an MPMC link.
+        std::size_t parallelism = 1;
+        // A cheap single-threaded stage runs on the thread of the stage before it instead of getting its own link.
+        bool cheap = false;
+        // Maximum amount of elements taken from the input link at once; their results go out as one chunk.
+        std::size_t batch = 32;
+    };
+
+    struct StageMetrics
+    {
+        std::string name;
+        // Stages fused onto the same threads share a segment.
+        std::size_t segment = 0;
+        std::size_t processed = 0;
+        std::size_t queued = 0;
+        double throughput = 0;
+    };
+
+    namespace detail
+    {
+        class LinkBase
+        {
+        public:
+            virtual ~LinkBase() = default;
+
+            std::size_t Occupancy() const
+            {
+                const auto popped = popped_.load(std::memory_order_relaxed);
+                const auto pushed = pushed_.load(std::memory_order_relaxed);
+                return pushed > popped ? pushed - popped : 0;
+            }
+
+            void AddProducers(std::size_t amount)
+            {
+                producers_.fetch_add(amount, std::memory_order_relaxed);
+            }
+
+            void ProducerDone()
+            {
+                producers_.fetch_sub(1, std::memory_order_release);
+            }
+
+            bool Closed() const
+            {
+                return producers_.load(std::memory_order_acquire) == 0;
+            }
+
+            void Pushed(std::size_t amount)
+            {
+                pushed_.fetch_add(amount, std::memory_order_relaxed);
+            }
+
+            void Popped(std::size_t amount)
+            {
+                popped_.fetch_add(amount, std::memory_order_relaxed);
+            }
+
+        private:
+            alignas(alignment::hardware_destructive_interference_size) std::atomic<std::size_t> pushed_{0};
+            alignas(alignment::hardware_destructive_interference_size) std::atomic<std::size_t> popped_{0};
+            std::atomic<std::size_t> producers_{0};
+        };
+
+        template <class T, std::size_t Capacity>
+        class Link : public LinkBase
+        {
+        public:
+            explicit Link(bool shared)
+            {
+                if (shared)
+                {
+                    mpmc_ = std::make_unique<lockfree::MPMCRingBuffer<T, Capacity>>();
+                }
+                else
+                {
+                    spsc_ = std::make_unique<lockfree::SPSCRingBuffer<T, Capacity>>();
+                }
+            }
+
+            bool Push(T&& value)
+            {
+                return spsc_ ? spsc_->Push(std::move(value)) : mpmc_->Push(std::move(value));
+            }
+
+            // Moves as many values as fit; an SPSC ring publishes them with one store.
+            std::size_t PushBatch(std::span<T> values)
+            {
+                if (spsc_)
+                {
+                    return spsc_->PushBatch(values);
+                }
+
+                std::size_t pushed = 0;
+                while (pushed < values.size() && mpmc_->Push(std::move(values[pushed])))
+                {
+                    ++pushed;
+                }
+                return pushed;
+            }
+
+            std::optional<T> Pop()
+            {
+                return spsc_ ? spsc_->Pop() : mpmc_->Pop();
+            }
+
+        private:
+            std::unique_ptr<lockfree::SPSCRingBuffer<T, Capacity>> spsc_;
+            std::unique_ptr<lockfree::MPMCRingBuffer<T, Capacity>> mpmc_;
+        };
+
+        template <class T, std::size_t Capacity>
+        void PushBlocking(Link<T, Capacity>& link, T&& value)
+        {
+            while (!link.Push(std::move(value)))
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        template <class T>
+        class Output
+        {
+        public:
+            // Takes every value and leaves the vector empty.
+            virtual void Push(std::vector<T>& values) = 0;
+            // Called once by every thread that feeds this output when it has nothing more to send.
+            virtual void Done() = 0;
+
+        protected:
+            ~Output() = default;
+        };
+
+        // Hands elements over to the next segment through its ring.
+        template <class T, std::size_t Capacity>
+        class RingOutput final : public Output<T>
+        {
+        public:
+            explicit RingOutput(Link<T, Capacity>& link)
+                : link_(link)
+            {
+            }
+
+            void Push(std::vector<T>& values) override
+            {
+                std::span<T> pending(values);
+                while (!pending.empty())
+                {
+                    const auto pushed = link_.PushBatch(pending);
+                    if (pushed == 0)
+                    {
+                        std::this_thread::yield();
+                        continue;
+                    }
+
+                    link_.Pushed(pushed);
+                    pending = pending.subspan(pushed);
+                }
+                values.clear();
+            }
+
+            void Done() override
+            {
+                link_.ProducerDone();
+            }
+
+        private:
+            Link<T, Capacity>& link_;
+        };
+
+        class StageBase
+        {
+        public:
+            StageBase(std::string name, std::size_t segment, std::size_t threads)
+                : name(std::move(name))
+                , segment(segment)
+                , threads(threads)
+            {
+            }
+
+            virtual ~StageBase() = default;
+
+            // Starts the workers of a stage that heads a segment.
+            virtual void Launch(std::vector<std::jthread>& threads) = 0;
+
+            virtual const LinkBase* Input() const = 0;
+
+            const std::string name;
+            const std::size_t segment;
+            // Threads that run this stage: its own workers, or the ones of the segment it is fused into.
+            const std::size_t threads;
+            alignas(alignment::hardware_destructive_interference_size) std::atomic<std::size_t> processed{0};
+        };
+
+        template <class Out>
+        class Producer : public StageBase
+        {
+        public:
+            using StageBase::StageBase;
+
+            Output<Out>* next = nullptr;
+        };
+
+        template <class In, class Out, std::size_t Capacity>
+        class Stage final : public Producer<Out>, public Output<In>
+        {
+            struct NoOutputs
+            {
+            };
+
+            // Results of one input batch, handed to the next stage in one go.
+            using Outputs = std::conditional_t<std::is_void_v<Out>, NoOutputs, std::vector<Out>>;
+
+        public:
+            Stage(std::string name, std::size_t segment, std::size_t threads, std::function<Out(In)> fn, std::shared_ptr<Link<In, Capacity>> link, std::size_t batch)
+                : Producer<Out>(std::move(name), segment, threads)
+                , fn_(std::move(fn))
+                , link_(std::move(link))
+                , feed_(link_ ? std::make_unique<RingOutput<In, Capacity>>(*link_) : nullptr)
+                , batch_(batch)
+            {
+            }
+
+            // What the previous stage pushes into: the ring of this segment, or the stage itself when fused.
+            Output<In>& Feed()
+            {
+                return feed_ ? static_cast<Output<In>&>(*feed_) : *this;
+            }
+
+            void Push(std::vector<In>& values) override
+            {
+                const auto amount = values.size();
+                Process(values, fused_outputs_);
+                this->processed.fetch_add(amount, std::memory_order_relaxed);
+            }
+
+            void Done() override
+            {
+                if constexpr (!std::is_void_v<Out>)
+                {
+                    this->next->Done();
+                }
+            }
+
+            void Launch(std::vector<std::jthread>& threads) override
+            {
+                if (!link_)
+                {
+                    return;
+                }
+
+                for (std::size_t i = 0; i < this->threads; ++i)
+                {
+                    threads.emplace_back([this]() { Work(); });
+                }
+            }
+
+            const LinkBase* Input() const override
+            {
+                return link_.get();
+            }
+
+        private:
+            void Process(std::vector<In>& values, Outputs& outputs)
+            {
+                if constexpr (std::is_void_v<Out>)
+                {
+                    for (auto& value : values)
+                    {
+                        fn_(std::move(value));
+                    }
+                }
+                else
+                {
+                    for (auto& value : values)
+                    {
+                        outputs.push_back(fn_(std::move(value)));
+                    }
+                    this->next->Push(outputs);
+                }
+                values.clear();
+            }
+
+            void Work()
+            {
+                std::vector<In> batch;
+                batch.reserve(batch_);
+                Outputs outputs;
+                if constexpr (!std::is_void_v<Out>)
+                {
+                    outputs.reserve(batch_);
+                }
+
+                while (true)
+                {
+                    while (batch.size() < batch_)
+                    {
+                        auto value = link_->Pop();
+                        if (!value)
+                        {
+                            break;
+                        }
+                        batch.push_back(std::move(*value));
+                    }
+
+                    if (batch.empty())
+                    {
+                        if (!link_->Closed())
+                        {
+                            std::this_thread::yield();
+                            continue;
+                        }
+
+                        // Producers are done, but the last of their elements may have landed after our Pop.
+                        auto value = link_->Pop();
+                        if (!value)
+                        {
+                            break;
+                        }
+                        batch.push_back(std::move(*value));
+                    }
+
+                    const auto amount = batch.size();
+                    link_->Popped(amount);
+                    Process(batch, outputs);
+                    this->processed.fetch_add(amount, std::memory_order_relaxed);
+                }
+
+                Done();
+            }
+
+        private:
+            std::function<Out(In)> fn_;
+            std::shared_ptr<Link<In, Capacity>> link_;
+            std::unique_ptr<RingOutput<In, Capacity>> feed_;
+            const std::size_t batch_;
+            // Only fused stages use it, and those are only ever fed by the single thread of their segment.
+            Outputs fused_outputs_;
+        };
+    }
+
+    template <class In, std::size_t LinkCapacity = 1024, class Out = In>
+    class Builder;
+
+    template <class In, std::size_t LinkCapacity>
+    class Pipeline
+    {
+    public:
+        ~Pipeline()
+        {
+            Close();
+            Wait();
+        }
+
+        Pipeline(const Pipeline&) = delete;
+        Pipeline& operator=(const Pipeline&) = delete;
+
+        // Must be called from a single ingest thread. Spins while the first link is full.
+        void Push(In value)
+        {
+            detail::PushBlocking(*input_, std::move(value));
+            input_->Pushed(1);
+        }
+
+        // Stages drain everything pushed so far and then stop.
+        void Close()
+        {
+            if (!closed_.exchange(true, std::memory_order_acq_rel))
+            {
+                input_->ProducerDone();
+            }
+        }
+
+        // Returns once every stage has stopped, which only happens after Close().
+        void Wait()
+        {
+            for (auto& thread : threads_)
+            {
+                if (thread.joinable())
+                {
+                    thread.join();
+                }
+            }
+        }
+
+        std::vector<StageMetrics> Metrics() const
+        {
+            const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+
+            std::vector<StageMetrics> metrics;
+            metrics.reserve(stages_.size());
+            for (const auto& stage : stages_)
+            {
+                const auto processed = stage->processed.load(std::memory_order_relaxed);
+                const auto* input = stage->Input();
+                metrics.push_back({
+                    .name = stage->name,
+                    .segment = stage->segment,
+                    .processed = processed,
+                    .queued = input ? input->Occupancy() : 0,
+                    .throughput = elapsed > 0 ? static_cast<double>(processed) / elapsed : 0,
+                });
+            }
+
+            return metrics;
+        }
+
+    private:
+        template <class, std::size_t, class>
+        friend class Builder;
+
+        Pipeline(std::vector<std::unique_ptr<detail::StageBase>> stages, std::shared_ptr<detail::Link<In, LinkCapacity>> input)
+            : stages_(std::move(stages))
+            , input_(std::move(input))
+            , start_(std::chrono::steady_clock::now())
+        {
+            for (auto& stage : stages_)
+            {
+                stage->Launch(threads_);
+            }
+        }
+
+    private:
+        std::vector<std::unique_ptr<detail::StageBase>> stages_;
+        std::shared_ptr<detail::Link<In, LinkCapacity>> input_;
+        std::chrono::steady_clock::time_point start_;
+        std::atomic<bool> closed_{false};
+        std::vector<std::jthread> threads_;
+    };
+
+    // Typed pipeline builder:
+    //
+    //     auto pipeline = pipeline::Builder<std::string>()
+    //         .Then("parse", Parse)
+    //         .Then("enrich", Enrich, {.parallelism = 4})
+    //         .Then("tag", Tag, {.cheap = true})
+    //         .Sink("emit", Emit);
+    //
+    // Every stage that is not fused starts a segment: its own threads fed by an SPSC ring, or an MPMC ring when
+    // either side runs more than one thread. Stage functions with parallelism > 1 are called concurrently.
+    template <class In, std::size_t LinkCapacity, class Out>
+    class Builder
+    {
+        template <class, std::size_t, class>
+        friend class Builder;
+
+    public:
+        Builder() = default;
+
+        template <class Fn>
+        auto Then(std::string name, Fn fn, StageOptions options = {}) &&
+        {
+            using Next = std::invoke_result_t<Fn&, Out>;
+            static_assert(!std::is_void_v<Next>, "Use Sink() for a stage that returns nothing!");
+            return Add<Next>(std::move(name), std::move(fn), options);
+        }
+
+        template <class Fn>
+        Pipeline<In, LinkCapacity> Sink(std::string name, Fn fn, StageOptions options = {}) &&
+        {
+            static_assert(std::is_void_v<std::invoke_result_t<Fn&, Out>>, "Sink must return nothing!");
+            auto builder = Add<void>(std::move(name), std::move(fn), options);
+            return Pipeline<In, LinkCapacity>(std::move(builder.stages_), std::move(builder.input_));
+        }
+
+    private:
+        template <class Next, class Fn>
+        Builder<In, LinkCapacity, Next> Add(std::string name, Fn fn, StageOptions options)
+        {
+            const auto parallelism = std::max<std::size_t>(options.parallelism, 1);
+            const auto batch = std::max<std::size_t>(options.batch, 1);
+            const bool fused = last_ && options.cheap && parallelism == 1 && last_->threads == 1;
+
+            std::shared_ptr<detail::Link<Out, LinkCapacity>> link;
+            if (!fused)
+            {
+                link = std::make_shared<detail::Link<Out, LinkCapacity>>(parallelism > 1 || (last_ && last_->threads > 1));
+                link->AddProducers(last_ ? last_->threads : 1);
+            }
+
+            const auto segment = !last_ ? 0 : fused ? last_->segment : last_->segment + 1;
+            auto stage = std::make_unique<detail::Stage<Out, Next, LinkCapacity>>(std::move(name), segment, fused ? 1 : parallelism, std::move(fn), link, batch);
+
+            Builder<In, LinkCapacity, Next> next;
+            next.stages_ = std::move(stages_);
+            next.input_ = std::move(input_);
+            if (last_)
+            {
+                last_->next = &stage->Feed();
+            }
+            else if constexpr (std::is_same_v<Out, In>)
+            {
+                next.input_ = link;
+            }
+            if constexpr (!std::is_void_v<Next>)
+            {
+                next.last_ = stage.get();
+            }
+            next.stages_.push_back(std::move(stage));
+            return next;
+        }
+
+    private:
+        std::vector<std::unique_ptr<detail::StageBase>> stages_;
+        std::shared_ptr<detail::Link<In, LinkCapacity>> input_;
+        detail::Producer<Out>* last_ = nullptr;
+    };
+}
@@ -0,0 +1,405 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <MPMCRingBuffer.h>
+
+namespace timer
+{
+    using Clock = std::chrono::steady_clock;
+    using Task = std::function<void()>;
+
+    // Generation in the high half, node index in the low half, so a stale id never cancels a reused node. Ids
+    // handed out by the Post* calls have the top bit set instead and count up from an atomic counter.
+    using TimerId = uint64_t;
+
+    // Hierarchical timing wheel (Varghese & Lauck). Level L has 256 slots of 256^L ticks each; a timer sits
+    // in the level of the highest digit in which its expiry differs from the current tick and is cascaded one
+    // level down whenever the current tick reaches that digit. Eight levels cover the whole 64-bit tick range.
+    //
+    // Schedule, Cancel and Advance belong to the owner thread, the one that runs the tasks; both Schedule and
+    // Cancel are O(1). Other threads go through the lock-free Post* calls, which queue commands in an MPMC ring
+    // buffer drained at the start of every Advance. A posted timer's id is reserved before its command is
+    // queued, so it can be cancelled right away with either Cancel or PostCancel.
+    template <std::size_t InboxCapacity = 4096>
+    class TimingWheel
+    {
+        static constexpr std::size_t kBits = 8;
+        static constexpr std::size_t kSlots = 1 << kBits;
+        static constexpr std::size_t kLevels = 64 / kBits;
+        static constexpr uint32_t kNil = UINT32_MAX;
+        static constexpr TimerId kPosted = TimerId{1} << 63;
+        static constexpr uint32_t kGenerationMask = UINT32_MAX >> 1;
+
+        enum class State : uint8_t
+        {
+            Free,
+            Pending,
+            // Taken out of its slot by the running Advance and not run yet.
+            Expiring,
+            // Its task is running right now.
+            Running,
+        };
+
+        struct Node
+        {
+            Task task;
+            uint64_t expiry = 0;
+            uint64_t period = 0;
+            uint32_t prev = kNil;
+            uint32_t next = kNil;
+            uint32_t slot = kNil;
+            uint32_t generation = 0;
+            TimerId posted = 0;
+            State state = State::Free;
+            bool cancelled = false;
+        };
+
+        enum class CommandKind : uint8_t
+        {
+            Schedule,
+            Cancel,
+        };
+
+        struct Command
+        {
+            CommandKind kind = CommandKind::Schedule;
+            Clock::duration delay{};
+            Clock::duration period{};
+            Task task;
+            // The reserved id for Schedule, the target for Cancel.
+            TimerId id = 0;
+        };
+
+    public:
+        explicit TimingWheel(Clock::duration tick = std::chrono::milliseconds(1), Clock::time_point start = Clock::now())
+            : tick_(tick)
+            , start_(start)
+        {
+            heads_.fill(kNil);
+        }
+
+        TimingWheel(const TimingWheel&) = delete;
+        TimingWheel& operator=(const TimingWheel&) = delete;
+
+        // Owner thread. The task runs on the first Advance that moves the wheel `delay` past the tick of the last
+        // Advance, rounded up to whole ticks.
+        TimerId Schedule(Clock::duration delay, Task task)
+        {
+            return Add(Ticks(delay), 0, std::move(task));
+        }
+
+        // Owner thread. Runs every `period`, starting one period from now, until cancelled.
+        TimerId ScheduleEvery(Clock::duration period, Task task)
+        {
+            const auto ticks = std::max<uint64_t>(Ticks(period), 1);
+            return Add(ticks, ticks, std::move(task));
+        }
+
+        // Owner thread. False if the timer was cancelled or a one-shot already started running, including a
+        // one-shot cancelling itself from its own task. A periodic timer may cancel itself from its own task.
+        bool Cancel(TimerId id)
+        {
+            if (id & kPosted)
+            {
+                // Not known yet means either gone or still in the inbox.
+                auto found = posted_.find(id);
+                if (found == posted_.end())
+                {
+                    Drain();
+                    found = posted_.find(id);
+                    if (found == posted_.end())
+                    {
+                        return false;
+                    }
+                }
+                id = found->second;
+            }
+
+            const auto index = static_cast<uint32_t>(id);
+            if (index >= nodes_.size())
+            {
+                return false;
+            }
+
+            auto& node = nodes_[index];
+            if (node.generation != static_cast<uint32_t>(id >> 32) || node.state == State::Free || node.cancelled)
+            {
+                return false;
+            }
+
+            if (node.state == State::Running && node.period == 0)
+            {
+                return false;
+            }
+
+            if (node.state == State::Expiring || node.state == State::Running)
+            {
+                node.cancelled = true;
+                return true;
+            }
+
+            Unlink(index);
+            Release(index);
+            return true;
+        }
+
+        // Any thread. std::nullopt when the inbox is full.
+        std::optional<TimerId> Post(Clock::duration delay, Task task)
+        {
+            return Enqueue(Command{CommandKind::Schedule, delay, {}, std::move(task), 0});
+        }
+
+        std::optional<TimerId> PostEvery(Clock::duration period, Task task)
+        {
+            return Enqueue(Command{CommandKind::Schedule, period, period, std::move(task), 0});
+        }
+
+        // Any thread. False when the inbox is full.
+        bool PostCancel(TimerId id)
+        {
+            return inbox_.Push(Command{CommandKind::Cancel, {}, {}, {}, id});
+        }
+
+        // Owner thread. Applies the posted commands, moves the wheel up to `now` and runs every task that
+        // expired on the way. Returns how many tasks ran.
+        std::size_t Advance(Clock::time_point now = Clock::now())
+        {
+            Drain();
+
+            const auto target = now > start_ ? static_cast<uint64_t>((now - start_) / tick_) : 0;
+            std::size_t fired = 0;
+            while (current_ < target)
+            {
+                if (pending_ == 0)
+                {
+                    current_ = target;
+                    break;
+                }
+
+                fired += Tick();
+            }
+
+            return fired;
+        }
+
+        std::size_t Pending() const
+        {
+            return pending_;
+        }
+
+    private:
+        uint64_t Ticks(Clock::duration duration) const
+        {
+            return duration > Clock::duration::zero() ? static_cast<uint64_t>((duration + tick_ - Clock::duration(1)) / tick_) : 0;
+        }
+
+        std::optional<TimerId> Enqueue(Command command)
+        {
+            command.id = kPosted | next_posted_.fetch_add(1, std::memory_order_relaxed);
+            const auto id = command.id;
+            if (!inbox_.Push(std::move(command)))
+            {
+                return std::nullopt;
+            }
+            return id;
+        }
+
+        void Drain()
+        {
+            while (auto command = inbox_.Pop())
+            {
+                Apply(std::move(*command));
+            }
+        }
+
+        void Apply(Command command)
+        {
+            if (command.kind == CommandKind::Cancel)
+            {
+                Cancel(command.id);
+                return;
+            }
+
+            const auto id = command.period > Clock::duration::zero()
+                ? ScheduleEvery(command.period, std::move(command.task))
+                : Schedule(command.delay, std::move(command.task));
+            nodes_[static_cast<uint32_t>(id)].posted = command.id;
+            posted_.emplace(command.id, id);
+        }
+
+        TimerId Add(uint64_t delay, uint64_t period, Task task)
+        {
+            uint32_t index;
+            if (!free_.empty())
+            {
+                index = free_.back();
+                free_.pop_back();
+            }
+            else
+            {
+                index = static_cast<uint32_t>(nodes_.size());
+                nodes_.emplace_back();
+            }
+
+            auto& node = nodes_[index];
+            node.task = std::move(task);
+            // Expiring in the current tick would mean a full turn of level 0, so the earliest is the next one.
+            node.expiry = current_ + std::max<uint64_t>(delay, 1);
+            node.period = period;
+            node.cancelled = false;
+            Link(index);
+            ++pending_;
+
+            return (static_cast<uint64_t>(node.generation) << 32) | index;
+        }
+
+        void Release(uint32_t index)
+        {
+            auto& node = nodes_[index];
+            node.task = nullptr;
+            node.state = State::Free;
+            node.generation = (node.generation + 1) & kGenerationMask;
+            if (node.posted)
+            {
+                posted_.erase(std::exchange(node.posted, 0));
+            }
+            free_.push_back(index);
+            --pending_;
+        }
+
+        static std::size_t Digit(uint64_t tick, std::size_t level)
+        {
+            return (tick >> (level * kBits)) & (kSlots - 1);
+        }
+
+        void Link(uint32_t index)
+        {
+            auto& node = nodes_[index];
+            const auto differing = node.expiry ^ current_;
+            const auto level = differing ? (std::bit_width(differing) - 1) / kBits : 0;
+            const auto slot = static_cast<uint32_t>(level * kSlots + Digit(node.expiry, level));
+
+            node.state = State::Pending;
+            node.slot = slot;
+            node.prev = kNil;
+            node.next = heads_[slot];
+            if (node.next != kNil)
+            {
+                nodes_[node.next].prev = index;
+            }
+            heads_[slot] = index;
+        }
+
+        void Unlink(uint32_t index)
+        {
+            auto& node = nodes_[index];
+            if (node.prev != kNil)
+            {
+                nodes_[node.prev].next = node.next;
+            }
+            else
+            {
+                heads_[node.slot] = node.next;
+            }
+
+            if (node.next != kNil)
+            {
+                nodes_[node.next].prev = node.prev;
+            }
+        }
+
+        std::size_t Tick()
+        {
+            ++current_;
+
+            // Cascade every level whose lower digits all just rolled over, highest first, so that timers drop
+            // through as many levels as they need to.
+            std::size_t top = 0;
+            while (top + 1 < kLevels && (current_ & ((uint64_t{1} << ((top + 1) * kBits)) - 1)) == 0)
+            {
+                ++top;
+            }
+
+            for (auto level = top; level > 0; --level)
+            {
+                auto index = std::exchange(heads_[level * kSlots + Digit(current_, level)], kNil);
+                while (index != kNil)
+                {
+                    const auto next = nodes_[index].next;
+                    Link(index);
+                    index = next;
+                }
+            }
+
+            return Expire(std::exchange(heads_[Digit(current_, 0)], kNil));
+        }
+
+        // The whole slot is detached first, so tasks may schedule and cancel freely while the batch runs.
+        std::size_t Expire(uint32_t index)
+        {
+            batch_.clear();
+            for (; index != kNil; index = nodes_[index].next)
+            {
+                nodes_[index].state = State::Expiring;
+                batch_.push_back(index);
+            }
+
+            std::size_t fired = 0;
+            for (const auto expired : batch_)
+            {
+                if (nodes_[expired].cancelled)
+                {
+                    Release(expired);
+                    continue;
+                }
+
+                auto& node = nodes_[expired];
+                node.state = State::Running;
+                node.task();
+                ++fired;
+
+                if (node.period == 0 || node.cancelled)
+                {
+                    Release(expired);
+                    continue;
+                }
+
+                node.expiry = current_ + node.period;
+                Link(expired);
+            }
+
+            return fired;
+        }
+
+    private:
+        const Clock::duration tick_;
+        const Clock::time_point start_;
+        uint64_t current_ = 0;
+        std::size_t pending_ = 0;
+
+        // A deque never relocates nodes, so growing it costs no latency spike and references stay valid while
+        // tasks schedule new timers.
+        std::deque<Node> nodes_;
+        std::vector<uint32_t> free_;
+        std::vector<uint32_t> batch_;
+        std::array<uint32_t, kLevels * kSlots> heads_;
+        // Posted ids of the live timers that were scheduled through the inbox.
+        std::unordered_map<TimerId, TimerId> posted_;
+
+        lockfree::MPMCRingBuffer<Command, InboxCapacity> inbox_;
+        std::atomic<uint64_t> next_posted_{0};
+    };
+}
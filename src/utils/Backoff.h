@@ -0,0 +1,122 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <thread>
+
+#include <CpuRelax.h>
+
+// Backoff policies for CAS retry loops. A policy object lives for one operation: the loop creates it before
+// the first attempt and calls Wait() after every failed one.
+namespace backoff
+{
+    namespace detail
+    {
+        // xorshift32, one state per thread; only used to spread retries apart.
+        inline uint32_t Random()
+        {
+            thread_local uint32_t state = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&state)) | 1u;
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            return state;
+        }
+
+        inline void Spin(uint32_t limit)
+        {
+            const auto spins = 1 + Random() % limit;
+            for (uint32_t i = 0; i < spins; ++i)
+            {
+                cpu::Relax();
+            }
+        }
+    }
+
+    // Retries immediately.
+    struct None
+    {
+        void Wait() {}
+    };
+
+    // One pause instruction per retry: frees the pipeline for the SMT sibling without giving up the core.
+    struct Pause
+    {
+        void Wait()
+        {
+            cpu::Relax();
+        }
+    };
+
+    struct Yield
+    {
+        void Wait()
+        {
+            std::this_thread::yield();
+        }
+    };
+
+    // Pauses a random number of times in [1, window], doubling the window after every failure up to MaxSpins.
+    template <uint32_t MaxSpins = 1024>
+    class Exponential
+    {
+    public:
+        void Wait()
+        {
+            detail::Spin(window_);
+            window_ = std::min(window_ * 2, MaxSpins);
+        }
+
+    private:
+        uint32_t window_ = 1;
+    };
+
+    // Exponential backoff whose first window comes from the failure rate this thread has seen recently, so a
+    // contended thread does not have to rediscover the right delay on every operation.
+    template <uint32_t MaxSpins = 1024>
+    class Adaptive
+    {
+        // Moving average of failures per operation, in sixteenths.
+        static constexpr uint32_t kScale = 16;
+        static constexpr uint32_t kMaxShift = std::bit_width(MaxSpins) - 1;
+
+    public:
+        Adaptive()
+            : window_(1u << std::min(Rate() / kScale, kMaxShift))
+        {
+        }
+
+        Adaptive(const Adaptive&) = delete;
+        Adaptive& operator=(const Adaptive&) = delete;
+
+        ~Adaptive()
+        {
+            auto& rate = Rate();
+            rate = (rate * 7 + std::min(failures_, MaxSpins) * kScale) / 8;
+        }
+
+        void Wait()
+        {
+            ++failures_;
+            detail::Spin(window_);
+            window_ = std::min(window_ * 2, MaxSpins);
+        }
+
+    private:
+        static uint32_t& Rate()
+        {
+            thread_local uint32_t rate = 0;
+            return rate;
+        }
+
+    private:
+        uint32_t window_;
+        uint32_t failures_ = 0;
+    };
+
+    // Default of MPMCRingBuffer, MSQueue and UnboundedStack. This is a placeholder, not a measured choice: it
+    // keeps the tight retry those containers had before they took a policy. Backoff_bench has only run on a
+    // single CPU, where it measures the cost of Wait() rather than contention.
+    // TODO: run Backoff_bench on a multi-core (ideally SMT) host and pick the default per container from it.
+    using Default = None;
+}
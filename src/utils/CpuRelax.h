@@ -0,0 +1,14 @@
+#pragma once
+
+namespace cpu
+{
+    // Spin-wait hint: lets the sibling hyper-thread run and saves power while polling a cache line.
+    inline void Relax()
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#elif defined(__aarch64__)
+        asm volatile("yield");
+#endif
+    }
+}
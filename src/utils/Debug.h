@@ -0,0 +1,55 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+
+namespace debug
+{
+    // Marks one side of a container that only one thread may use at a time, e.g. the producer side of an
+    // SPSC queue. Handing the side over to another thread is fine; two threads inside it at once trip an
+    // assertion. Compiles to nothing with NDEBUG, so keep it as a [[no_unique_address]] member.
+    class ExclusiveUse
+    {
+    public:
+#ifdef NDEBUG
+        class Guard
+        {
+        };
+
+        Guard Enter()
+        {
+            return {};
+        }
+#else
+        class Guard
+        {
+        public:
+            explicit Guard(std::atomic<bool>& busy)
+                : busy_(busy)
+            {
+            }
+
+            Guard(const Guard&) = delete;
+            Guard& operator=(const Guard&) = delete;
+
+            ~Guard()
+            {
+                busy_.store(false, std::memory_order_release);
+            }
+
+        private:
+            std::atomic<bool>& busy_;
+        };
+
+        Guard Enter()
+        {
+            [[maybe_unused]] const bool wasBusy = busy_.exchange(true, std::memory_order_acquire);
+            assert(!wasBusy && "Single-threaded side of a container is used by two threads at once!");
+            return Guard(busy_);
+        }
+
+    private:
+        std::atomic<bool> busy_{false};
+#endif
+    };
+}
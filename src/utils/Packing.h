@@ -34,4 +34,14 @@ namespace packing
     {
         return static_cast<uint16_t>(data >> detail::kPointerShift);
     }
+
+    constexpr uint64_t PackPayloadWithData(uint64_t payload, uint16_t data)
+    {
+        return (static_cast<uint64_t>(data) << detail::kPointerShift) | (payload & detail::kPointerMask);
+    }
+
+    constexpr uint64_t UnpackPayload(uint64_t data)
+    {
+        return data & detail::kPointerMask;
+    }
 }
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <concepts>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace queue
+{
+    template <class Q>
+    using ElementOf = typename decltype(std::declval<Q&>().Pop())::value_type;
+
+    template <class Q>
+    using PushResultOf = decltype(std::declval<Q&>().Push(std::declval<ElementOf<Q>>()));
+
+    // What every by-value container in lockfree/ and blocking/ provides: Push() takes an element and either
+    // always succeeds (void) or reports a full container (bool), Pop() never blocks and returns std::nullopt
+    // when empty. Intrusive, keyed and overwriting containers have their own contracts and are not Queues.
+    template <class Q>
+    concept Queue = requires(Q& queue)
+    {
+        { queue.Pop() } -> std::same_as<std::optional<ElementOf<Q>>>;
+    } && requires(Q& queue, ElementOf<Q> value)
+    {
+        queue.Push(std::move(value));
+    } && (std::is_void_v<PushResultOf<Q>> || std::same_as<PushResultOf<Q>, bool>);
+
+    template <class Q>
+    concept BoundedQueue = Queue<Q> && std::same_as<PushResultOf<Q>, bool>;
+
+    template <class Q>
+    concept UnboundedQueue = Queue<Q> && std::is_void_v<PushResultOf<Q>>;
+
+    // Pushes into any Queue, returns false only when a bounded one is full.
+    template <Queue Q>
+    bool TryPush(Q& queue, ElementOf<Q> value)
+    {
+        if constexpr (UnboundedQueue<Q>)
+        {
+            queue.Push(std::move(value));
+            return true;
+        }
+        else
+        {
+            return queue.Push(std::move(value));
+        }
+    }
+}
@@ -0,0 +1,180 @@
+#include <gtest/gtest.h>
+
+#include <BatchedSPSCRingBuffer.h>
+#include <algorithm>
+#include <thread>
+
+namespace
+{
+    constexpr std::size_t BufferSize = 64;
+    constexpr std::size_t BatchSize = 8;
+    template <class T>
+    using RingBuffer = lockfree::BatchedSPSCRingBuffer<T, BufferSize, BatchSize>;
+}
+
+TEST(BatchedSPSCRingBuffer_Unit, PopEmptyReturnsStdNulloptTest) {
+    RingBuffer<int> queue;
+    ASSERT_EQ(queue.Pop(), std::nullopt);
+}
+
+TEST(BatchedSPSCRingBuffer_Unit, IdleConsumerSeesEveryPushTest) {
+    RingBuffer<int> queue;
+    constexpr int iterations = 100;
+    for (int i = 0; i < iterations; ++i)
+    {
+        queue.Push(i);
+        ASSERT_EQ(queue.Pop(), i);
+        ASSERT_EQ(queue.Batch(), 1u);
+    }
+}
+
+TEST(BatchedSPSCRingBuffer_Unit, BatchGrowsWhileConsumerLagsTest) {
+    RingBuffer<int> queue;
+    for (std::size_t i = 0; i < BatchSize; ++i)
+    {
+        ASSERT_TRUE(queue.Push(i));
+    }
+    ASSERT_EQ(queue.Batch(), 1u);
+
+    for (std::size_t i = BatchSize; i < BufferSize; ++i)
+    {
+        ASSERT_TRUE(queue.Push(i));
+    }
+    ASSERT_EQ(queue.Batch(), BatchSize);
+
+    // Once the consumer has caught up the next sample halves the batch.
+    queue.Flush();
+    while (queue.Pop()) {}
+    ASSERT_TRUE(queue.Push(0));
+    ASSERT_EQ(queue.Batch(), BatchSize / 2);
+}
+
+TEST(BatchedSPSCRingBuffer_Unit, QuietProducerBecomesVisibleWithoutFlushTest) {
+    constexpr std::size_t pending = BatchSize / 2;
+
+    RingBuffer<int> queue;
+    for (std::size_t i = 0; i < BufferSize; ++i)
+    {
+        queue.Push(static_cast<int>(i));
+    }
+    ASSERT_EQ(queue.Batch(), BatchSize);
+
+    // Free a batch of slots so the next pushes find the consumer still lagging and keep the batch.
+    for (std::size_t i = 0; i < BatchSize; ++i)
+    {
+        ASSERT_EQ(queue.Pop(), static_cast<int>(i));
+    }
+    for (std::size_t i = 0; i < pending; ++i)
+    {
+        ASSERT_TRUE(queue.Push(static_cast<int>(BufferSize + i)));
+    }
+    ASSERT_EQ(queue.Batch(), BatchSize);
+
+    std::size_t expected = BatchSize;
+    for (int poll = 0; poll < RingBuffer<int>::kIdlePolls + static_cast<int>(BufferSize); ++poll)
+    {
+        if (auto value = queue.Pop())
+        {
+            ASSERT_EQ(*value, static_cast<int>(expected));
+            ++expected;
+        }
+    }
+    ASSERT_EQ(expected, BufferSize + pending);
+}
+
+TEST(BatchedSPSCRingBuffer_Unit, CannotOverflowTest) {
+    RingBuffer<int> buffer;
+    for (std::size_t i = 0; i < BufferSize; ++i)
+    {
+        ASSERT_TRUE(buffer.Push(i));
+    }
+
+    ASSERT_FALSE(buffer.Push(0));
+    ASSERT_EQ(buffer.Pop(), 0);
+    ASSERT_FALSE(buffer.Push(0));
+
+    for (std::size_t i = 1; i < BufferSize; ++i)
+    {
+        ASSERT_EQ(buffer.Pop(), static_cast<int>(i));
+    }
+    ASSERT_TRUE(buffer.Push(0));
+}
+
+TEST(BatchedSPSCRingBuffer_Stress, BatchGrowsUnderSustainedLoadTest) {
+    constexpr int iterations = 1000000;
+    constexpr std::size_t maxBatch = 64;
+
+    // Far from full all the time, so only the lag samples can grow the batch.
+    lockfree::BatchedSPSCRingBuffer<int, 1 << 20, maxBatch> buffer;
+
+    std::size_t largestBatch = 0;
+    std::thread producer([&buffer, &largestBatch]()
+    {
+        for (int i = 0; i < iterations; ++i)
+        {
+            while (!buffer.Push(i)) {}
+            largestBatch = std::max(largestBatch, buffer.Batch());
+        }
+        buffer.Flush();
+    });
+
+    // A consumer that does a little work per element and so keeps falling behind.
+    int popped = 0;
+    std::thread consumer([&buffer, &popped]()
+    {
+        volatile int work = 0;
+        while (popped < iterations)
+        {
+            if (buffer.Pop())
+            {
+                ++popped;
+                for (int i = 0; i < 16; ++i)
+                {
+                    work = work + i;
+                }
+            }
+        }
+    });
+
+    producer.join();
+    consumer.join();
+
+    ASSERT_EQ(popped, iterations);
+    ASSERT_GT(largestBatch, 1u);
+}
+
+TEST(BatchedSPSCRingBuffer_Stress, ConcurrentPushAndPopReturnsAllElementsInOrderTest) {
+    constexpr int iterations = 1000000;
+
+    lockfree::BatchedSPSCRingBuffer<int, 1 << 16, 256> buffer;
+
+    std::thread producer([&buffer]()
+    {
+       for (int i = 0; i < iterations; ++i)
+       {
+           while (!buffer.Push(i)) {}
+       }
+       buffer.Flush();
+    });
+
+    auto popped = 0;
+    bool ordered = true;
+    std::thread consumer([&buffer, &popped, &ordered]()
+    {
+        while (popped < iterations)
+        {
+            if (auto value = buffer.Pop())
+            {
+                ordered = ordered && *value == popped;
+                ++popped;
+            }
+        }
+    });
+
+    producer.join();
+    consumer.join();
+
+    ASSERT_EQ(popped, iterations);
+    ASSERT_TRUE(ordered);
+    ASSERT_EQ(buffer.Pop(), std::nullopt);
+}
@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+
+#include <Channel.h>
+#include <ManualExecutor.h>
+#include <Task.h>
+#include <ThreadPool.h>
+
+#include <latch>
+
+namespace
+{
+    constexpr std::size_t BufferSize = 4;
+
+    template <class Channel>
+    coro::Task Produce(Channel& channel, int from, int to, std::latch& done)
+    {
+        for (int i = from; i < to; ++i)
+        {
+            co_await channel.Push(i);
+        }
+        done.count_down();
+    }
+
+    template <class Channel>
+    coro::Task Consume(Channel& channel, int amount, std::atomic<long long>& sum, std::latch& done)
+    {
+        for (int i = 0; i < amount; ++i)
+        {
+            sum.fetch_add(co_await channel.Pop(), std::memory_order_relaxed);
+        }
+        done.count_down();
+    }
+}
+
+TEST(Channel_Unit, TryPushTryPopTest)
+{
+    coro::SPSCChannel<int, BufferSize> channel;
+    ASSERT_EQ(channel.TryPop(), std::nullopt);
+    for (std::size_t i = 0; i < BufferSize; ++i)
+    {
+        ASSERT_TRUE(channel.TryPush(static_cast<int>(i)));
+    }
+    ASSERT_FALSE(channel.TryPush(0));
+    ASSERT_EQ(channel.TryPop(), 0);
+}
+
+TEST(Channel_Unit, PopSuspendsUntilValueArrivesTest)
+{
+    coro::ManualExecutor executor;
+    coro::SPSCChannel<int, BufferSize> channel;
+    std::optional<int> received;
+
+    Spawn(executor, [](auto& channel, auto& received) -> coro::Task
+    {
+        received = co_await channel.Pop();
+    }(channel, received));
+
+    ASSERT_EQ(executor.RunAll(), 1u);
+    ASSERT_EQ(received, std::nullopt);
+
+    ASSERT_TRUE(channel.TryPush(5));
+    ASSERT_EQ(executor.RunAll(), 1u);
+    ASSERT_EQ(received, 5);
+}
+
+TEST(Channel_Unit, PushSuspendsUntilSpaceAppearsTest)
+{
+    coro::ManualExecutor executor;
+    coro::MPMCChannel<int, BufferSize> channel;
+    bool finished = false;
+
+    Spawn(executor, [](auto& channel, bool& finished) -> coro::Task
+    {
+        for (std::size_t i = 0; i <= BufferSize; ++i)
+        {
+            co_await channel.Push(static_cast<int>(i));
+        }
+        finished = true;
+    }(channel, finished));
+
+    executor.RunAll();
+    ASSERT_FALSE(finished);
+
+    ASSERT_EQ(channel.TryPop(), 0);
+    executor.RunAll();
+    ASSERT_TRUE(finished);
+}
+
+TEST(Channel_Unit, SingleThreadedPingPongTest)
+{
+    constexpr int iterations = 1000;
+
+    coro::ManualExecutor executor;
+    coro::SPSCChannel<int, BufferSize> channel;
+    std::atomic<long long> sum = 0;
+    std::latch done(2);
+
+    Spawn(executor, Consume(channel, iterations, sum, done));
+    Spawn(executor, Produce(channel, 0, iterations, done));
+    executor.RunAll();
+
+    ASSERT_TRUE(done.try_wait());
+    ASSERT_EQ(sum, iterations * (iterations - 1LL) / 2);
+}
+
+TEST(Channel_Stress, SPSCOnThreadPoolTest)
+{
+    constexpr int iterations = 100000;
+
+    coro::ThreadPool pool(2);
+    coro::SPSCChannel<int, BufferSize> channel;
+    std::atomic<long long> sum = 0;
+    std::latch done(2);
+
+    Spawn(pool, Consume(channel, iterations, sum, done));
+    Spawn(pool, Produce(channel, 0, iterations, done));
+    done.wait();
+
+    ASSERT_EQ(sum, iterations * (iterations - 1LL) / 2);
+    ASSERT_EQ(channel.TryPop(), std::nullopt);
+}
+
+TEST(Channel_Stress, MPMCOnThreadPoolTest)
+{
+    constexpr int iterations = 30000;
+    constexpr int producersAmount = 3;
+    constexpr int consumersAmount = 2;
+
+    coro::ThreadPool pool(4);
+    coro::MPMCChannel<int, BufferSize> channel;
+    std::atomic<long long> sum = 0;
+    std::latch done(producersAmount + consumersAmount);
+
+    for (int i = 0; i < consumersAmount; ++i)
+    {
+        Spawn(pool, Consume(channel, iterations * producersAmount / consumersAmount, sum, done));
+    }
+    for (int i = 0; i < producersAmount; ++i)
+    {
+        Spawn(pool, Produce(channel, i * iterations, (i + 1) * iterations, done));
+    }
+    done.wait();
+
+    const long long total = iterations * producersAmount;
+    ASSERT_EQ(sum, total * (total - 1) / 2);
+    ASSERT_EQ(channel.TryPop(), std::nullopt);
+}
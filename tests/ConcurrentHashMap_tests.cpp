@@ -0,0 +1,257 @@
+#include <gtest/gtest.h>
+
+#include <ConcurrentHashMap.h>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    using HashMap = lockfree::ConcurrentHashMap<uint64_t, uint32_t>;
+}
+
+TEST(ConcurrentHashMap_Unit, DefaultCtorTest)
+{
+    [[maybe_unused]] HashMap map;
+}
+
+TEST(ConcurrentHashMap_Unit, FindMissingReturnsStdNulloptTest) {
+    HashMap map;
+    ASSERT_EQ(map.Find(1), std::nullopt);
+}
+
+TEST(ConcurrentHashMap_Unit, InsertFindReturnsSameValueTest) {
+    HashMap map;
+    ASSERT_TRUE(map.Insert(1, 5));
+    ASSERT_EQ(map.Find(1), 5u);
+    ASSERT_EQ(map.Size(), 1u);
+}
+
+TEST(ConcurrentHashMap_Unit, InsertExistingKeyFailsTest) {
+    HashMap map;
+    ASSERT_TRUE(map.Insert(1, 5));
+    ASSERT_FALSE(map.Insert(1, 6));
+    ASSERT_EQ(map.Find(1), 5u);
+}
+
+TEST(ConcurrentHashMap_Unit, UpdateTest) {
+    HashMap map;
+    ASSERT_FALSE(map.Update(1, 5));
+    ASSERT_TRUE(map.Insert(1, 5));
+    ASSERT_TRUE(map.Update(1, 6));
+    ASSERT_EQ(map.Find(1), 6u);
+}
+
+TEST(ConcurrentHashMap_Unit, InsertOrAssignTest) {
+    HashMap map;
+    ASSERT_TRUE(map.InsertOrAssign(1, 5));
+    ASSERT_FALSE(map.InsertOrAssign(1, 6));
+    ASSERT_EQ(map.Find(1), 6u);
+}
+
+TEST(ConcurrentHashMap_Unit, CompareExchangeTest) {
+    HashMap map;
+    ASSERT_FALSE(map.CompareExchange(1, 5, 6));
+    map.Insert(1, 5);
+    ASSERT_FALSE(map.CompareExchange(1, 4, 6));
+    ASSERT_TRUE(map.CompareExchange(1, 5, 6));
+    ASSERT_EQ(map.Find(1), 6u);
+}
+
+TEST(ConcurrentHashMap_Unit, EraseLeavesTombstoneThatCanBeReusedTest) {
+    HashMap map;
+    ASSERT_FALSE(map.Erase(1));
+    map.Insert(1, 5);
+    ASSERT_TRUE(map.Erase(1));
+    ASSERT_FALSE(map.Erase(1));
+    ASSERT_EQ(map.Find(1), std::nullopt);
+    ASSERT_EQ(map.Size(), 0u);
+
+    ASSERT_TRUE(map.Insert(1, 7));
+    ASSERT_EQ(map.Find(1), 7u);
+}
+
+TEST(ConcurrentHashMap_Unit, GrowsPastInitialCapacityTest) {
+    HashMap map(16);
+    constexpr uint64_t keys = 10000;
+    for (uint64_t key = 1; key <= keys; ++key)
+    {
+        ASSERT_TRUE(map.Insert(key, static_cast<uint32_t>(key * 2)));
+    }
+
+    ASSERT_GE(map.Capacity(), keys);
+    ASSERT_EQ(map.Size(), keys);
+    for (uint64_t key = 1; key <= keys; ++key)
+    {
+        ASSERT_EQ(map.Find(key), key * 2);
+    }
+}
+
+TEST(ConcurrentHashMap_Unit, ChurnDoesNotGrowTableTest) {
+    HashMap map(64);
+    for (uint64_t key = 1; key <= 100000; ++key)
+    {
+        ASSERT_TRUE(map.Insert(key, 1));
+        ASSERT_TRUE(map.Erase(key));
+        // Every rehash retires a table; only the ones a pin may still reach are kept.
+        ASSERT_LE(map.Tables(), 3u);
+    }
+
+    ASSERT_EQ(map.Capacity(), 64u);
+    ASSERT_EQ(map.Size(), 0u);
+}
+
+TEST(ConcurrentHashMap_Stress, ConcurrentChurnFreesRetiredTablesTest) {
+    constexpr uint64_t keysPerThread = 50000;
+    constexpr uint64_t threadsAmount = 4;
+
+    HashMap map(64);
+    {
+        std::vector<std::jthread> threads;
+        for (uint64_t t = 0; t < threadsAmount; ++t)
+        {
+            threads.emplace_back([&map, t]()
+            {
+                for (uint64_t key = t * keysPerThread + 1; key <= (t + 1) * keysPerThread; ++key)
+                {
+                    map.Insert(key, 1);
+                    map.Find(key);
+                    map.Erase(key);
+                }
+            });
+        }
+    }
+
+    // One more rehash after the threads are gone frees whatever they still had pinned.
+    for (uint64_t key = 1; map.Tables() > 2 && key <= 1000; ++key)
+    {
+        map.Insert(key, 1);
+        map.Erase(key);
+    }
+    ASSERT_LE(map.Tables(), 2u);
+    ASSERT_EQ(map.Size(), 0u);
+}
+
+TEST(ConcurrentHashMap_Unit, CustomEmptyKeyTest) {
+    lockfree::ConcurrentHashMap<int, int> map(64, -1);
+    ASSERT_TRUE(map.Insert(0, 5));
+    ASSERT_EQ(map.Find(0), 5);
+}
+
+TEST(ConcurrentHashMap_Unit, PointerValuesTest) {
+    lockfree::ConcurrentHashMap<uint64_t, int*> map;
+    int value = 5;
+    map.Insert(1, &value);
+    ASSERT_EQ(map.Find(1), &value);
+}
+
+TEST(ConcurrentHashMap_Stress, ConcurrentInsertersWithResizeTest) {
+    constexpr uint64_t keysPerThread = 20000;
+    constexpr uint64_t threadsAmount = 4;
+
+    HashMap map(16);
+
+    {
+        std::vector<std::jthread> threads(threadsAmount);
+        for (uint64_t t = 0; t < threadsAmount; ++t)
+        {
+            threads[t] = std::jthread([&map, t]()
+            {
+                for (uint64_t i = 0; i < keysPerThread; ++i)
+                {
+                    const auto key = 1 + t * keysPerThread + i;
+                    map.Insert(key, static_cast<uint32_t>(key));
+                }
+            });
+        }
+    }
+
+    ASSERT_EQ(map.Size(), keysPerThread * threadsAmount);
+    for (uint64_t key = 1; key <= keysPerThread * threadsAmount; ++key)
+    {
+        ASSERT_EQ(map.Find(key), key);
+    }
+}
+
+TEST(ConcurrentHashMap_Stress, ReadersSeeMonotonicValuesDuringUpdatesTest) {
+    constexpr uint64_t keys = 64;
+    constexpr uint32_t iterations = 20000;
+
+    HashMap map(16);
+    for (uint64_t key = 1; key <= keys; ++key)
+    {
+        map.Insert(key, 0);
+    }
+
+    std::atomic<bool> isFinished = false;
+    std::atomic<bool> isMonotonic = true;
+    std::jthread reader([&]()
+    {
+        std::vector<uint32_t> lastSeen(keys + 1, 0);
+        while (!isFinished.load(std::memory_order_acquire))
+        {
+            for (uint64_t key = 1; key <= keys; ++key)
+            {
+                const auto value = map.Find(key);
+                if (!value || *value < lastSeen[key])
+                {
+                    isMonotonic.store(false, std::memory_order_relaxed);
+                }
+                lastSeen[key] = value.value_or(0);
+            }
+        }
+    });
+
+    std::jthread grower([&]()
+    {
+        for (uint64_t key = keys + 1; key <= keys + iterations; ++key)
+        {
+            map.Insert(key, 0);
+        }
+    });
+
+    for (uint32_t i = 1; i <= iterations; ++i)
+    {
+        for (uint64_t key = 1; key <= keys; key += 7)
+        {
+            ASSERT_TRUE(map.Update(key, i));
+        }
+    }
+
+    grower.join();
+    isFinished.store(true, std::memory_order_release);
+    reader.join();
+
+    ASSERT_TRUE(isMonotonic.load());
+    ASSERT_EQ(map.Find(1), iterations);
+}
+
+TEST(ConcurrentHashMap_Stress, ConcurrentCompareExchangeCountsEveryIncrementTest) {
+    constexpr uint32_t incrementsPerThread = 10000;
+    constexpr uint32_t threadsAmount = 3;
+
+    HashMap map;
+    map.Insert(1, 0);
+
+    {
+        std::vector<std::jthread> threads(threadsAmount);
+        for (auto& thread : threads)
+        {
+            thread = std::jthread([&map]()
+            {
+                for (uint32_t i = 0; i < incrementsPerThread; ++i)
+                {
+                    while (true)
+                    {
+                        const auto current = *map.Find(1);
+                        if (map.CompareExchange(1, current, current + 1))
+                        {
+                            break;
+                        }
+                    }
+                }
+            });
+        }
+    }
+
+    ASSERT_EQ(map.Find(1), incrementsPerThread * threadsAmount);
+}
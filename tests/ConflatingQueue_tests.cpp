@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+
+#include <ConflatingQueue.h>
+
+#include <array>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    constexpr std::size_t KeysAmount = 8;
+    template <class T>
+    using Queue = lockfree::ConflatingQueue<T, KeysAmount>;
+
+    struct CountedAllocations
+    {
+        static void* operator new(std::size_t size)
+        {
+            ++allocations;
+            return ::operator new(size);
+        }
+
+        static void operator delete(void* ptr)
+        {
+            ::operator delete(ptr);
+        }
+
+        static inline int allocations = 0;
+        int value = 0;
+    };
+}
+
+TEST(ConflatingQueue_Unit, PopEmptyReturnsStdNulloptTest)
+{
+    Queue<int> queue;
+    ASSERT_TRUE(queue.Empty());
+    ASSERT_EQ(queue.Pop(), std::nullopt);
+}
+
+TEST(ConflatingQueue_Unit, PendingValueIsReplacedTest)
+{
+    Queue<int> queue;
+    ASSERT_TRUE(queue.Push(3, 1));
+    ASSERT_FALSE(queue.Push(3, 2));
+    ASSERT_FALSE(queue.Push(3, 3));
+
+    ASSERT_EQ(queue.Pop(), std::make_pair(std::size_t{3}, 3));
+    ASSERT_EQ(queue.Pop(), std::nullopt);
+
+    ASSERT_TRUE(queue.Push(3, 4));
+    ASSERT_EQ(queue.Pop(), std::make_pair(std::size_t{3}, 4));
+}
+
+TEST(ConflatingQueue_Unit, KeysComeOutInFirstPendingOrderTest)
+{
+    Queue<int> queue;
+    queue.Push(5, 1);
+    queue.Push(2, 1);
+    queue.Push(5, 2);
+    queue.Push(7, 1);
+
+    ASSERT_EQ(queue.Pop(), std::make_pair(std::size_t{5}, 2));
+    ASSERT_EQ(queue.Pop(), std::make_pair(std::size_t{2}, 1));
+    ASSERT_EQ(queue.Pop(), std::make_pair(std::size_t{7}, 1));
+    ASSERT_TRUE(queue.Empty());
+}
+
+TEST(ConflatingQueue_Unit, DisplacedValuesAreReusedTest)
+{
+    Queue<CountedAllocations> queue;
+    queue.Push(1, {1});
+    queue.Push(1, {2});
+    ASSERT_EQ(queue.Pop()->second.value, 2);
+
+    const auto warm = CountedAllocations::allocations;
+    for (int i = 0; i < 100; ++i)
+    {
+        queue.Push(1, {i});
+        queue.Push(1, {i + 1});
+        ASSERT_EQ(queue.Pop()->second.value, i + 1);
+    }
+    ASSERT_EQ(CountedAllocations::allocations, warm);
+}
+
+TEST(ConflatingQueue_Unit, EveryKeyCanBePendingAtOnceTest)
+{
+    Queue<std::unique_ptr<int>> queue;
+    for (std::size_t key = 0; key < KeysAmount; ++key)
+    {
+        ASSERT_TRUE(queue.Push(key, std::make_unique<int>(static_cast<int>(key))));
+    }
+
+    for (std::size_t key = 0; key < KeysAmount; ++key)
+    {
+        auto element = queue.Pop();
+        ASSERT_TRUE(element.has_value());
+        ASSERT_EQ(element->first, key);
+        ASSERT_EQ(*element->second, static_cast<int>(key));
+    }
+}
+
+TEST(ConflatingQueue_Stress, ConsumersEndWithLatestValuePerKeyTest)
+{
+    constexpr int iterations = 100000;
+    constexpr int producersAmount = 2;
+    constexpr int consumersAmount = 2;
+
+    // Every producer owns half of the keys and writes increasing values to them.
+    Queue<int> queue;
+    std::array<std::atomic<int>, KeysAmount> latest{};
+    std::atomic<int> producersDone = 0;
+
+    auto consume = [&queue, &latest]()
+    {
+        while (auto element = queue.Pop())
+        {
+            auto& seen = latest[element->first];
+            auto current = seen.load(std::memory_order_relaxed);
+            while (current < element->second && !seen.compare_exchange_weak(current, element->second)) {}
+        }
+    };
+
+    {
+        std::vector<std::jthread> threads;
+        for (int p = 0; p < producersAmount; ++p)
+        {
+            threads.emplace_back([&queue, &producersDone, p]()
+            {
+                for (int i = 1; i <= iterations; ++i)
+                {
+                    for (std::size_t key = p; key < KeysAmount; key += producersAmount)
+                    {
+                        queue.Push(key, i);
+                    }
+                }
+                producersDone.fetch_add(1);
+            });
+        }
+
+        for (int c = 0; c < consumersAmount; ++c)
+        {
+            threads.emplace_back([&consume, &producersDone]()
+            {
+                while (producersDone.load() < producersAmount)
+                {
+                    consume();
+                }
+                consume();
+            });
+        }
+    }
+
+    for (auto& seen : latest)
+    {
+        ASSERT_EQ(seen.load(), iterations);
+    }
+    ASSERT_TRUE(queue.Empty());
+}
@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+
+#include <IntrusiveMPSCQueue.h>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    struct Message : lockfree::MPSCQueueHook
+    {
+        int value = 0;
+    };
+
+    using Queue = lockfree::IntrusiveMPSCQueue<Message>;
+}
+
+TEST(IntrusiveMPSCQueue_Unit, PopEmptyQueueReturnsNullptrTest) {
+    Queue queue;
+    ASSERT_TRUE(queue.Empty());
+    ASSERT_EQ(queue.Pop(), nullptr);
+}
+
+TEST(IntrusiveMPSCQueue_Unit, PushPopReturnsSameElementTest) {
+    Queue queue;
+    Message message;
+    message.value = 5;
+    queue.Push(&message);
+    ASSERT_FALSE(queue.Empty());
+    ASSERT_EQ(queue.Pop(), &message);
+    ASSERT_TRUE(queue.Empty());
+    ASSERT_EQ(queue.Pop(), nullptr);
+}
+
+TEST(IntrusiveMPSCQueue_Unit, ElementCanBeReusedAfterPopTest) {
+    Queue queue;
+    Message message;
+    constexpr int iterations = 100;
+    for (int i = 0; i < iterations; ++i)
+    {
+        message.value = i;
+        queue.Push(&message);
+        auto* popped = queue.Pop();
+        ASSERT_EQ(popped, &message);
+        ASSERT_EQ(popped->value, i);
+    }
+}
+
+TEST(IntrusiveMPSCQueue_Unit, PopKeepsFifoOrderTest) {
+    Queue queue;
+    std::vector<Message> messages(10);
+    for (int i = 0; i < 10; ++i)
+    {
+        messages[i].value = i;
+        queue.Push(&messages[i]);
+    }
+
+    for (int i = 0; i < 10; ++i)
+    {
+        ASSERT_EQ(queue.Pop()->value, i);
+    }
+    ASSERT_EQ(queue.Pop(), nullptr);
+}
+
+TEST(IntrusiveMPSCQueue_Unit, PopAllStopsAtSnapshotTest) {
+    Queue queue;
+    std::vector<Message> messages(10);
+    for (int i = 0; i < 5; ++i)
+    {
+        messages[i].value = i;
+        queue.Push(&messages[i]);
+    }
+
+    std::vector<int> drained;
+    const auto popped = queue.PopAll([&](Message* message)
+    {
+        drained.push_back(message->value);
+        if (message->value < 5)
+        {
+            messages[message->value + 5].value = message->value + 5;
+            queue.Push(&messages[message->value + 5]);
+        }
+    });
+
+    ASSERT_EQ(popped, 5u);
+    ASSERT_EQ(drained, (std::vector<int>{0, 1, 2, 3, 4}));
+    ASSERT_EQ(queue.PopAll([](Message*) {}), 5u);
+    ASSERT_EQ(queue.PopAll([](Message*) {}), 0u);
+}
+
+TEST(IntrusiveMPSCQueue_Unit, PopAllAfterStubWasRelinkedTest) {
+    Queue queue;
+    std::vector<Message> messages(4);
+    queue.Push(&messages[0]);
+    queue.Push(&messages[1]);
+    ASSERT_EQ(queue.Pop(), &messages[0]);
+    // Popping the only element puts the stub back at the head.
+    ASSERT_EQ(queue.Pop(), &messages[1]);
+    ASSERT_EQ(queue.PopAll([](Message*) {}), 0u);
+
+    queue.Push(&messages[2]);
+    queue.Push(&messages[3]);
+
+    // Every element goes straight back in, so each call must stop after the two that were there.
+    const auto requeue = [&queue](Message* message) { queue.Push(message); };
+    for (int round = 0; round < 4; ++round)
+    {
+        ASSERT_EQ(queue.PopAll(requeue), 2u);
+    }
+    ASSERT_EQ(queue.Pop(), &messages[2]);
+    ASSERT_EQ(queue.Pop(), &messages[3]);
+    ASSERT_EQ(queue.Pop(), nullptr);
+}
+
+TEST(IntrusiveMPSCQueue_Stress, ConcurrentProducersKeepPerProducerOrderTest) {
+    constexpr int iterations = 200000;
+    constexpr int producersAmount = 3;
+
+    Queue queue;
+    std::vector<std::vector<Message>> messages(producersAmount, std::vector<Message>(iterations));
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < producersAmount; ++p)
+    {
+        producers.emplace_back([&queue, &messages, p]()
+        {
+            for (int i = 0; i < iterations; ++i)
+            {
+                messages[p][i].value = p * iterations + i;
+                queue.Push(&messages[p][i]);
+            }
+        });
+    }
+
+    std::vector<int> last(producersAmount, -1);
+    bool ordered = true;
+    int popped = 0;
+    while (popped < iterations * producersAmount)
+    {
+        popped += static_cast<int>(queue.PopAll([&](Message* message)
+        {
+            const auto producer = message->value / iterations;
+            const auto index = message->value % iterations;
+            ordered = ordered && index == last[producer] + 1;
+            last[producer] = index;
+        }));
+    }
+
+    for (auto& producer : producers)
+    {
+        producer.join();
+    }
+
+    ASSERT_TRUE(ordered);
+    ASSERT_EQ(popped, iterations * producersAmount);
+    ASSERT_EQ(queue.Pop(), nullptr);
+}
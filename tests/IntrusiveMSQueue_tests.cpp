@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+
+#include <IntrusiveMSQueue.h>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    struct Request : lockfree::MSQueueHook
+    {
+        int value = 0;
+        int handled = 0;
+    };
+
+    using Queue = lockfree::IntrusiveMSQueue<Request>;
+}
+
+TEST(IntrusiveMSQueue_Unit, PopEmptyQueueReturnsNullptrTest) {
+    Queue queue;
+    ASSERT_TRUE(queue.Empty());
+    ASSERT_EQ(queue.Pop(), nullptr);
+}
+
+TEST(IntrusiveMSQueue_Unit, PushPopReturnsSameElementTest) {
+    Queue queue;
+    Request request;
+    queue.Push(&request);
+    ASSERT_FALSE(queue.Empty());
+    ASSERT_EQ(queue.Pop(), &request);
+    ASSERT_TRUE(queue.Empty());
+    ASSERT_EQ(queue.Pop(), nullptr);
+}
+
+TEST(IntrusiveMSQueue_Unit, ElementCanBeReusedAfterPopTest) {
+    Queue queue;
+    Request request;
+    constexpr int iterations = 100;
+    for (int i = 0; i < iterations; ++i)
+    {
+        queue.Push(&request);
+        ASSERT_EQ(queue.Pop(), &request);
+        ASSERT_EQ(queue.Pop(), nullptr);
+    }
+}
+
+TEST(IntrusiveMSQueue_Unit, PopKeepsFifoOrderTest) {
+    Queue queue;
+    std::vector<Request> requests(10);
+    for (int i = 0; i < 10; ++i)
+    {
+        requests[i].value = i;
+        queue.Push(&requests[i]);
+    }
+
+    for (int i = 0; i < 5; ++i)
+    {
+        auto* request = queue.Pop();
+        ASSERT_EQ(request->value, i);
+        queue.Push(request);
+    }
+
+    for (int i = 0; i < 10; ++i)
+    {
+        ASSERT_EQ(queue.Pop()->value, (i + 5) % 10);
+    }
+    ASSERT_EQ(queue.Pop(), nullptr);
+}
+
+TEST(IntrusiveMSQueue_Stress, SingleProducerSingleConsumerKeepsOrderTest) {
+    constexpr int iterations = 1000000;
+
+    Queue queue;
+    std::vector<Request> requests(iterations);
+
+    std::thread producer([&queue, &requests]()
+    {
+        for (int i = 0; i < iterations; ++i)
+        {
+            requests[i].value = i;
+            queue.Push(&requests[i]);
+        }
+    });
+
+    int popped = 0;
+    bool ordered = true;
+    while (popped < iterations)
+    {
+        if (auto* request = queue.Pop())
+        {
+            ordered = ordered && request->value == popped;
+            ++popped;
+        }
+    }
+    producer.join();
+
+    ASSERT_TRUE(ordered);
+    ASSERT_EQ(queue.Pop(), nullptr);
+}
+
+TEST(IntrusiveMSQueue_Stress, RecycledElementsAreNeverLostOrDuplicatedTest) {
+    constexpr int iterations = 200000;
+    constexpr int threadsAmount = 4;
+    constexpr int poolSize = 8;
+
+    Queue queue;
+    std::vector<Request> pool(poolSize);
+    for (auto& request : pool)
+    {
+        queue.Push(&request);
+    }
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadsAmount; ++t)
+    {
+        threads.emplace_back([&queue]()
+        {
+            for (int i = 0; i < iterations; ++i)
+            {
+                Request* request;
+                while (!(request = queue.Pop())) {}
+                ++request->handled;
+                queue.Push(request);
+            }
+        });
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    int handled = 0;
+    for (const auto& request : pool)
+    {
+        handled += request.handled;
+    }
+    ASSERT_EQ(handled, iterations * threadsAmount);
+
+    int remaining = 0;
+    while (queue.Pop())
+    {
+        ++remaining;
+    }
+    ASSERT_EQ(remaining, poolSize);
+}
@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+
+#include <IntrusiveUnboundedStack.h>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    struct Request : lockfree::UnboundedStackHook
+    {
+        int value = 0;
+        int handled = 0;
+    };
+
+    using Stack = lockfree::IntrusiveUnboundedStack<Request>;
+}
+
+TEST(IntrusiveUnboundedStack_Unit, PopEmptyStackReturnsNullptrTest) {
+    Stack stack;
+    ASSERT_TRUE(stack.Empty());
+    ASSERT_EQ(stack.Pop(), nullptr);
+}
+
+TEST(IntrusiveUnboundedStack_Unit, PushPopReturnsSameElementTest) {
+    Stack stack;
+    Request request;
+    stack.Push(&request);
+    ASSERT_FALSE(stack.Empty());
+    ASSERT_EQ(stack.Pop(), &request);
+    ASSERT_EQ(stack.Pop(), nullptr);
+}
+
+TEST(IntrusiveUnboundedStack_Unit, PopKeepsLifoOrderTest) {
+    Stack stack;
+    std::vector<Request> requests(10);
+    for (int i = 0; i < 10; ++i)
+    {
+        requests[i].value = i;
+        stack.Push(&requests[i]);
+    }
+
+    for (int i = 9; i >= 0; --i)
+    {
+        ASSERT_EQ(stack.Pop()->value, i);
+    }
+    ASSERT_EQ(stack.Pop(), nullptr);
+}
+
+TEST(IntrusiveUnboundedStack_Stress, RecycledElementsAreNeverLostOrDuplicatedTest) {
+    constexpr int iterations = 200000;
+    constexpr int threadsAmount = 4;
+    constexpr int poolSize = 8;
+
+    Stack stack;
+    std::vector<Request> pool(poolSize);
+    for (auto& request : pool)
+    {
+        stack.Push(&request);
+    }
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadsAmount; ++t)
+    {
+        threads.emplace_back([&stack]()
+        {
+            for (int i = 0; i < iterations; ++i)
+            {
+                Request* request;
+                while (!(request = stack.Pop())) {}
+                ++request->handled;
+                stack.Push(request);
+            }
+        });
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    int handled = 0;
+    for (const auto& request : pool)
+    {
+        handled += request.handled;
+    }
+    ASSERT_EQ(handled, iterations * threadsAmount);
+
+    int remaining = 0;
+    while (stack.Pop())
+    {
+        ++remaining;
+    }
+    ASSERT_EQ(remaining, poolSize);
+}
@@ -0,0 +1,242 @@
+#include <gtest/gtest.h>
+
+#include <Journal.h>
+
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    constexpr std::size_t SegmentSize = 4096;
+
+    class TempDirectory
+    {
+    public:
+        TempDirectory()
+            : path_(std::filesystem::temp_directory_path() / ("journal_test_" + std::to_string(::getpid()) + "_" + std::to_string(counter_++)))
+        {
+            std::filesystem::remove_all(path_);
+        }
+
+        ~TempDirectory()
+        {
+            std::filesystem::remove_all(path_);
+        }
+
+        journal::Options Options(journal::Sync sync = journal::Sync::None, std::size_t syncEvery = 64) const
+        {
+            return {.directory = path_, .segmentSize = SegmentSize, .sync = sync, .syncEvery = syncEvery};
+        }
+
+        std::filesystem::path Segment(uint64_t segment) const
+        {
+            return path_ / ("segment-" + std::to_string(segment));
+        }
+
+        std::size_t Segments() const
+        {
+            std::size_t segments = 0;
+            for (const auto& entry : std::filesystem::directory_iterator(path_))
+            {
+                segments += entry.path().filename().string().starts_with("segment-");
+            }
+            return segments;
+        }
+
+    private:
+        static inline int counter_ = 0;
+        std::filesystem::path path_;
+    };
+
+    void Append(journal::Journal& journal, std::string_view text)
+    {
+        journal.Append(std::as_bytes(std::span(text)));
+    }
+
+    std::optional<std::string> Pop(journal::Journal& journal)
+    {
+        const auto record = journal.Peek();
+        if (!record)
+        {
+            return std::nullopt;
+        }
+
+        std::string text(reinterpret_cast<const char*>(record->data()), record->size());
+        journal.Consume();
+        return text;
+    }
+}
+
+TEST(Journal_Unit, AppendThenPopTest)
+{
+    TempDirectory directory;
+    journal::Journal journal(directory.Options());
+    ASSERT_EQ(journal.Peek(), std::nullopt);
+
+    Append(journal, "first");
+    Append(journal, "");
+    journal.Append(42);
+
+    ASSERT_EQ(Pop(journal), "first");
+    ASSERT_EQ(Pop(journal), "");
+    const auto record = journal.Peek();
+    ASSERT_TRUE(record.has_value());
+    ASSERT_EQ(record->size(), sizeof(int));
+    ASSERT_EQ(*reinterpret_cast<const int*>(record->data()), 42);
+    journal.Consume();
+    ASSERT_EQ(journal.Peek(), std::nullopt);
+}
+
+TEST(Journal_Unit, RecordsSurviveReopenTest)
+{
+    TempDirectory directory;
+    {
+        journal::Journal journal(directory.Options());
+        Append(journal, "consumed");
+        Append(journal, "pending");
+        ASSERT_EQ(Pop(journal), "consumed");
+    }
+
+    journal::Journal journal(directory.Options());
+    ASSERT_EQ(Pop(journal), "pending");
+    ASSERT_EQ(Pop(journal), std::nullopt);
+
+    Append(journal, "after restart");
+    ASSERT_EQ(Pop(journal), "after restart");
+}
+
+TEST(Journal_Unit, RecordsCrossSegmentsAndConsumedSegmentsAreRemovedTest)
+{
+    constexpr int records = 1000;
+
+    TempDirectory directory;
+    journal::Journal journal(directory.Options());
+    for (int i = 0; i < records; ++i)
+    {
+        Append(journal, std::string(i % 300, 'a' + i % 26));
+    }
+    ASSERT_GT(directory.Segments(), 10u);
+
+    int replayed = 0;
+    journal.Replay([&replayed](std::span<const std::byte> record)
+    {
+        ASSERT_EQ(record.size(), static_cast<std::size_t>(replayed % 300));
+        if (!record.empty())
+        {
+            ASSERT_EQ(static_cast<char>(record.front()), 'a' + replayed % 26);
+        }
+        ++replayed;
+    });
+
+    ASSERT_EQ(replayed, records);
+    ASSERT_EQ(directory.Segments(), 1u);
+}
+
+TEST(Journal_Unit, ConsumerCursorMovesPastRemovedSegmentsTest)
+{
+    // Three records fill a segment, so the fourth goes into the next one.
+    const std::string record(SegmentSize / 3 - 16, 'r');
+
+    TempDirectory directory;
+    {
+        journal::Journal journal(directory.Options());
+        for (int i = 0; i < 3; ++i)
+        {
+            Append(journal, record);
+        }
+        Append(journal, "next segment");
+
+        for (int i = 0; i < 3; ++i)
+        {
+            ASSERT_EQ(Pop(journal), record);
+        }
+
+        // Moving to segment 1 removes segment 0 although nothing in segment 1 is consumed yet.
+        ASSERT_TRUE(journal.Peek().has_value());
+        ASSERT_FALSE(std::filesystem::exists(directory.Segment(0)));
+    }
+
+    journal::Journal journal(directory.Options());
+    ASSERT_EQ(Pop(journal), "next segment");
+    ASSERT_EQ(Pop(journal), std::nullopt);
+    ASSERT_FALSE(std::filesystem::exists(directory.Segment(0)));
+}
+
+TEST(Journal_Unit, MissingSegmentIsReportedAsCorruptionTest)
+{
+    TempDirectory directory;
+    {
+        journal::Journal journal(directory.Options());
+        Append(journal, "lost");
+    }
+    std::filesystem::remove(directory.Segment(0));
+
+    journal::Journal journal(directory.Options());
+    ASSERT_THROW(journal.Peek(), std::runtime_error);
+    ASSERT_FALSE(std::filesystem::exists(directory.Segment(0)));
+}
+
+TEST(Journal_Unit, BatchedSyncHidesRecordsUntilCommitTest)
+{
+    TempDirectory directory;
+    for (const auto sync : {journal::Sync::Msync, journal::Sync::Fdatasync})
+    {
+        journal::Journal journal(directory.Options(sync, 3));
+        Append(journal, "one");
+        Append(journal, "two");
+        ASSERT_EQ(journal.Peek(), std::nullopt);
+
+        Append(journal, "three");
+        ASSERT_EQ(Pop(journal), "one");
+
+        Append(journal, "four");
+        journal.Sync();
+        ASSERT_EQ(journal.Replay([](auto) {}), 3u);
+    }
+}
+
+TEST(Journal_Unit, InvalidUseThrowsTest)
+{
+    TempDirectory directory;
+    {
+        journal::Journal journal(directory.Options());
+        ASSERT_THROW(Append(journal, std::string(SegmentSize, 'x')), std::length_error);
+    }
+
+    auto options = directory.Options();
+    options.segmentSize *= 2;
+    ASSERT_THROW(journal::Journal{options}, std::runtime_error);
+    options.segmentSize = 1000;
+    ASSERT_THROW(journal::Journal{options}, std::invalid_argument);
+}
+
+TEST(Journal_Stress, ConsumerSeesEveryRecordInOrderTest)
+{
+    constexpr uint64_t iterations = 200000;
+
+    TempDirectory directory;
+    journal::Journal journal(directory.Options());
+    std::thread producer([&journal]()
+    {
+        for (uint64_t i = 0; i < iterations; ++i)
+        {
+            journal.Append(i);
+        }
+    });
+
+    uint64_t expected = 0;
+    while (expected < iterations)
+    {
+        journal.Replay([&expected](std::span<const std::byte> record)
+        {
+            ASSERT_EQ(*reinterpret_cast<const uint64_t*>(record.data()), expected);
+            ++expected;
+        });
+    }
+    producer.join();
+
+    ASSERT_EQ(journal.Peek(), std::nullopt);
+}
@@ -0,0 +1,162 @@
+#include <gtest/gtest.h>
+
+#include <BlockingRingBuffer.h>
+#include <Locks.h>
+
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    // The non-atomic read-modify-write only adds up if the lock really excludes.
+    template <class Lock>
+    void CheckMutualExclusion(int threadsAmount, int iterations)
+    {
+        Lock lock;
+        long long counter = 0;
+
+        std::vector<std::thread> threads;
+        for (int i = 0; i < threadsAmount; ++i)
+        {
+            threads.emplace_back([&]()
+            {
+                for (int j = 0; j < iterations; ++j)
+                {
+                    std::lock_guard guard(lock);
+                    counter = counter + 1;
+                }
+            });
+        }
+
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+
+        ASSERT_EQ(counter, static_cast<long long>(threadsAmount) * iterations);
+    }
+
+    template <class Lock>
+    void CheckRingBufferPushPop(int threadsAmount, int iterations)
+    {
+        blocking::BlockingRingBuffer<int, 64, Lock> queue;
+        std::atomic<long long> sum = 0;
+
+        std::vector<std::thread> threads;
+        for (int i = 0; i < threadsAmount; ++i)
+        {
+            threads.emplace_back([&]()
+            {
+                for (int j = 0; j < iterations; ++j)
+                {
+                    while (!queue.Push(j)) {}
+                    std::optional<int> value;
+                    while (!(value = queue.Pop())) {}
+                    sum.fetch_add(*value, std::memory_order_relaxed);
+                }
+            });
+        }
+
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+
+        ASSERT_EQ(sum, threadsAmount * (iterations * (iterations - 1LL) / 2));
+        ASSERT_EQ(queue.Pop(), std::nullopt);
+    }
+}
+
+TEST(Locks_Unit, LockUnlockSingleThreadTest)
+{
+    CheckMutualExclusion<blocking::TTASLock>(1, 100);
+    CheckMutualExclusion<blocking::TicketLock>(1, 100);
+    CheckMutualExclusion<blocking::MCSLock>(1, 100);
+    CheckMutualExclusion<blocking::CLHLock>(1, 100);
+    CheckMutualExclusion<blocking::HybridLock>(1, 100);
+}
+
+TEST(Locks_Unit, TryLockFailsWhileHeldTest)
+{
+    blocking::TTASLock ttas;
+    ASSERT_TRUE(ttas.try_lock());
+    ASSERT_FALSE(ttas.try_lock());
+    ttas.unlock();
+    ASSERT_TRUE(ttas.try_lock());
+    ttas.unlock();
+
+    blocking::HybridLock hybrid;
+    ASSERT_TRUE(hybrid.try_lock());
+    ASSERT_FALSE(hybrid.try_lock());
+    hybrid.unlock();
+    ASSERT_TRUE(hybrid.try_lock());
+    hybrid.unlock();
+}
+
+TEST(Locks_Unit, QueueLocksCanBeNestedTest)
+{
+    blocking::MCSLock firstMcs;
+    blocking::MCSLock secondMcs;
+    firstMcs.lock();
+    secondMcs.lock();
+    firstMcs.unlock();
+    secondMcs.unlock();
+
+    blocking::CLHLock firstClh;
+    blocking::CLHLock secondClh;
+    firstClh.lock();
+    secondClh.lock();
+    firstClh.unlock();
+    secondClh.unlock();
+}
+
+TEST(Locks_Unit, RingBufferWithSpinLockTest)
+{
+    blocking::BlockingRingBuffer<int, 4, blocking::TicketLock> queue;
+    for (int i = 0; i < 4; ++i)
+    {
+        ASSERT_TRUE(queue.Push(i));
+    }
+    ASSERT_FALSE(queue.Push(4));
+    for (int i = 0; i < 4; ++i)
+    {
+        ASSERT_EQ(queue.Pop(), i);
+    }
+    ASSERT_EQ(queue.Pop(), std::nullopt);
+}
+
+TEST(Locks_Stress, TTASLockMutualExclusionTest)
+{
+    CheckMutualExclusion<blocking::TTASLock>(4, 100000);
+}
+
+TEST(Locks_Stress, TicketLockMutualExclusionTest)
+{
+    CheckMutualExclusion<blocking::TicketLock>(4, 100000);
+}
+
+TEST(Locks_Stress, MCSLockMutualExclusionTest)
+{
+    CheckMutualExclusion<blocking::MCSLock>(4, 100000);
+}
+
+TEST(Locks_Stress, CLHLockMutualExclusionTest)
+{
+    CheckMutualExclusion<blocking::CLHLock>(4, 100000);
+}
+
+TEST(Locks_Stress, HybridLockMutualExclusionTest)
+{
+    CheckMutualExclusion<blocking::HybridLock>(4, 100000);
+}
+
+TEST(Locks_Stress, RingBufferWithEveryLockTest)
+{
+    CheckRingBufferPushPop<std::mutex>(4, 10000);
+    CheckRingBufferPushPop<blocking::TTASLock>(4, 10000);
+    CheckRingBufferPushPop<blocking::TicketLock>(4, 10000);
+    CheckRingBufferPushPop<blocking::MCSLock>(4, 10000);
+    CheckRingBufferPushPop<blocking::CLHLock>(4, 10000);
+    CheckRingBufferPushPop<blocking::HybridLock>(4, 10000);
+}
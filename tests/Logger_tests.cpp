@@ -0,0 +1,230 @@
+#include <gtest/gtest.h>
+
+#include <Logger.h>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    class TempFile
+    {
+    public:
+        TempFile()
+            : path_(std::filesystem::temp_directory_path() / ("logger_test_" + std::to_string(::getpid()) + "_" + std::to_string(counter_++) + ".log"))
+        {
+            std::filesystem::remove(path_);
+        }
+
+        ~TempFile()
+        {
+            std::filesystem::remove(path_);
+        }
+
+        const std::filesystem::path& Path() const
+        {
+            return path_;
+        }
+
+        std::vector<std::string> Lines() const
+        {
+            std::ifstream file(path_);
+            std::vector<std::string> lines;
+            for (std::string line; std::getline(file, line);)
+            {
+                lines.push_back(line);
+            }
+            return lines;
+        }
+
+    private:
+        static inline int counter_ = 0;
+        std::filesystem::path path_;
+    };
+
+    // Everything after the "[T<n>] " prefix.
+    std::string Message(const std::string& line)
+    {
+        return line.substr(line.find("] ") + 2);
+    }
+
+    enum class Side
+    {
+        Buy = 1,
+        Sell = 2,
+    };
+}
+
+TEST(Logger_Unit, FormatPlaceholdersTest)
+{
+    std::string out;
+    logging::detail::Format(out, "{} + {} = {} {{}} {}", 1, 2.5, "three", 'x');
+    ASSERT_EQ(out, "1 + 2.5 = three {} x");
+
+    out.clear();
+    logging::detail::Format(out, "{} {} {}", true, Side::Sell);
+    ASSERT_EQ(out, "true 2 {}");
+}
+
+TEST(Logger_Unit, RecordsAreFormattedInOrderTest)
+{
+    TempFile file;
+    {
+        logging::Logger logger({.path = file.Path()});
+        LOGGING_INFO(logger, "starting");
+        for (int i = 0; i < 100; ++i)
+        {
+            LOGGING_WARNING(logger, "order {} side {} price {}", i, Side::Buy, 100.25);
+        }
+    }
+
+    const auto lines = file.Lines();
+    ASSERT_EQ(lines.size(), 101u);
+    ASSERT_NE(lines[0].find(" INFO [T0] starting"), std::string::npos);
+    for (int i = 0; i < 100; ++i)
+    {
+        ASSERT_NE(lines[i + 1].find(" WARNING "), std::string::npos);
+        ASSERT_EQ(Message(lines[i + 1]), "order " + std::to_string(i) + " side 1 price 100.25");
+    }
+}
+
+TEST(Logger_Unit, StringArgumentsAreCopiedTest)
+{
+    TempFile file;
+    const std::string longString(500, 'a');
+    {
+        logging::Logger logger({.path = file.Path()});
+        char buffer[16] = "stack";
+        LOGGING_INFO(logger, "{} {} {}", buffer, std::string("temporary").c_str(), std::string_view("view"));
+        std::strcpy(buffer, "overwritten");
+
+        const char* null = nullptr;
+        LOGGING_INFO(logger, "{} {}", null, 7);
+        LOGGING_INFO(logger, "{} {}", longString.c_str(), longString.c_str());
+    }
+
+    const auto lines = file.Lines();
+    ASSERT_EQ(lines.size(), 3u);
+    ASSERT_EQ(Message(lines[0]), "stack temporary view");
+    ASSERT_EQ(Message(lines[1]), "(null) 7");
+
+    // Truncated to the record, the second string only gets its length byte.
+    const auto truncated = Message(lines[2]);
+    ASSERT_LT(truncated.size(), 128u);
+    ASSERT_EQ(truncated, std::string(truncated.size() - 1, 'a') + " ");
+}
+
+TEST(Logger_Unit, ThreadOutlivesItsLoggersTest)
+{
+    TempFile kept;
+    logging::Logger keptLogger({.path = kept.Path()});
+    for (int i = 0; i < 50; ++i)
+    {
+        TempFile file;
+        {
+            logging::Logger logger({.path = file.Path()});
+            LOGGING_INFO(logger, "short {}", i);
+            LOGGING_INFO(keptLogger, "kept {}", i);
+        }
+
+        const auto lines = file.Lines();
+        ASSERT_EQ(lines.size(), 1u);
+        ASSERT_EQ(Message(lines[0]), "short " + std::to_string(i));
+    }
+
+    keptLogger.Flush();
+    const auto lines = kept.Lines();
+    ASSERT_EQ(lines.size(), 50u);
+    ASSERT_EQ(Message(lines[49]), "kept 49");
+}
+
+TEST(Logger_Unit, FlushWritesEverythingLoggedBeforeTest)
+{
+    TempFile file;
+    logging::Logger logger({.path = file.Path(), .idle = std::chrono::microseconds(100'000)});
+    LOGGING_ERROR(logger, "first {}", 1);
+    LOGGING_ERROR(logger, "second {}", 2);
+    logger.Flush();
+
+    const auto lines = file.Lines();
+    ASSERT_EQ(lines.size(), 2u);
+    ASSERT_EQ(Message(lines[1]), "second 2");
+}
+
+TEST(Logger_Unit, DropPolicyCountsLostRecordsTest)
+{
+    constexpr std::size_t ringCapacity = 16;
+
+    TempFile file;
+    uint64_t dropped = 0;
+    {
+        // The background thread sleeps long enough for the ring to overflow.
+        logging::Logger<logging::FullPolicy::Drop, ringCapacity> logger({.path = file.Path(), .idle = std::chrono::microseconds(200'000)});
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        for (int i = 0; i < 100; ++i)
+        {
+            LOGGING_INFO(logger, "{}", i);
+        }
+        dropped = logger.Dropped();
+    }
+
+    ASSERT_GE(dropped, 100 - ringCapacity);
+    ASSERT_EQ(file.Lines().size() + dropped, 100u);
+}
+
+TEST(Logger_Unit, OverwritePolicyKeepsNewestRecordsTest)
+{
+    constexpr std::size_t ringCapacity = 16;
+
+    TempFile file;
+    {
+        logging::Logger<logging::FullPolicy::Overwrite, ringCapacity> logger({.path = file.Path(), .idle = std::chrono::microseconds(200'000)});
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        for (int i = 0; i < 100; ++i)
+        {
+            LOGGING_INFO(logger, "{}", i);
+        }
+    }
+
+    const auto lines = file.Lines();
+    ASSERT_FALSE(lines.empty());
+    ASSERT_EQ(Message(lines.back()), "99");
+}
+
+TEST(Logger_Stress, BlockPolicyLosesNothingAcrossThreadsTest)
+{
+    constexpr int iterations = 20000;
+    constexpr int threadsAmount = 4;
+
+    TempFile file;
+    {
+        logging::Logger<logging::FullPolicy::Block, 64> logger({.path = file.Path()});
+        std::vector<std::jthread> threads;
+        for (int t = 0; t < threadsAmount; ++t)
+        {
+            threads.emplace_back([&logger, t]()
+            {
+                for (int i = 0; i < iterations; ++i)
+                {
+                    LOGGING_DEBUG(logger, "thread {} record {}", t, i);
+                }
+            });
+        }
+    }
+
+    // Per thread, records keep their order.
+    std::vector<int> next(threadsAmount, 0);
+    const auto lines = file.Lines();
+    ASSERT_EQ(lines.size(), static_cast<std::size_t>(iterations * threadsAmount));
+    for (const auto& line : lines)
+    {
+        int thread = 0;
+        int record = 0;
+        ASSERT_EQ(std::sscanf(Message(line).c_str(), "thread %d record %d", &thread, &record), 2);
+        ASSERT_EQ(record, next[thread]++);
+    }
+}
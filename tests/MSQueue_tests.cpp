@@ -59,6 +59,12 @@ TEST(MSQueue_Stress, ConcurrentPushAndPopReturnsAllElements) {
                 ++popped;
             }
         }
+
+        // The producer may have finished after our last Pop.
+        while (queue.Pop())
+        {
+            ++popped;
+        }
     });
 
     producer.join();
@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+
+#include <MPMCRingBuffer.h>
+#include <NodeAllocator.h>
+#include <SPSCRingBuffer.h>
+#include <Topology.h>
+
+#include <thread>
+
+namespace
+{
+    constexpr std::size_t BufferSize = 1024;
+}
+
+TEST(Numa_Unit, CurrentCpuIsReportedTest)
+{
+    const auto cpus = numa::Cpus();
+    ASSERT_FALSE(cpus.empty());
+    for (const auto& cpu : cpus)
+    {
+        ASSERT_GE(cpu.node, 0);
+        ASSERT_LT(cpu.node, numa::NodeCount());
+    }
+}
+
+TEST(Numa_Unit, FindPairMatchesPlacementTest)
+{
+    const std::vector<numa::Cpu> cpus = {
+        {.id = 0, .core = 0, .socket = 0, .node = 0},
+        {.id = 1, .core = 1, .socket = 0, .node = 0},
+        {.id = 2, .core = 0, .socket = 1, .node = 1},
+        {.id = 3, .core = 0, .socket = 0, .node = 0},
+    };
+
+    const auto sameCore = numa::FindPair(numa::Placement::SameCore, cpus);
+    ASSERT_TRUE(sameCore.has_value());
+    ASSERT_EQ(sameCore->first.id, 0);
+    ASSERT_EQ(sameCore->second.id, 3);
+
+    const auto sameSocket = numa::FindPair(numa::Placement::SameSocket, cpus);
+    ASSERT_TRUE(sameSocket.has_value());
+    ASSERT_EQ(sameSocket->first.id, 0);
+    ASSERT_EQ(sameSocket->second.id, 1);
+
+    const auto crossSocket = numa::FindPair(numa::Placement::CrossSocket, cpus);
+    ASSERT_TRUE(crossSocket.has_value());
+    ASSERT_NE(crossSocket->first.socket, crossSocket->second.socket);
+}
+
+TEST(Numa_Unit, SingleCpuHasNoPairsTest)
+{
+    const std::vector<numa::Cpu> cpus = {{.id = 0, .core = 0, .socket = 0, .node = 0}};
+    ASSERT_EQ(numa::FindPair(numa::Placement::SameCore, cpus), std::nullopt);
+    ASSERT_EQ(numa::FindPair(numa::Placement::SameSocket, cpus), std::nullopt);
+    ASSERT_EQ(numa::FindPair(numa::Placement::CrossSocket, cpus), std::nullopt);
+}
+
+TEST(Numa_Unit, PinCurrentThreadTest)
+{
+    const auto cpu = numa::Cpus().back();
+    std::jthread([cpu]()
+    {
+        ASSERT_TRUE(numa::PinCurrentThread(cpu.id));
+        ASSERT_EQ(sched_getcpu(), cpu.id);
+    });
+}
+
+TEST(Numa_Unit, RingBuffersOnCurrentNodeTest)
+{
+    const numa::NodeAllocator<int> allocator(numa::CurrentNode());
+
+    lockfree::SPSCRingBuffer<int, BufferSize, numa::NodeAllocator<int>> spsc(allocator);
+    lockfree::MPMCRingBuffer<int, BufferSize, numa::NodeAllocator<int>> mpmc(allocator);
+    for (std::size_t i = 0; i < BufferSize; ++i)
+    {
+        ASSERT_TRUE(spsc.Push(static_cast<int>(i)));
+        ASSERT_TRUE(mpmc.Push(static_cast<int>(i)));
+    }
+    ASSERT_FALSE(spsc.Push(0));
+    ASSERT_FALSE(mpmc.Push(0));
+
+    for (std::size_t i = 0; i < BufferSize; ++i)
+    {
+        ASSERT_EQ(spsc.Pop(), static_cast<int>(i));
+        ASSERT_EQ(mpmc.Pop(), static_cast<int>(i));
+    }
+}
+
+TEST(Numa_Unit, FirstTouchFallbackTest)
+{
+    auto buffer = numa::MakeOnNode<lockfree::SPSCRingBuffer<int, BufferSize, numa::NodeAllocator<int>>>(
+        numa::kFirstTouch, numa::NodeAllocator<int>(numa::kFirstTouch));
+
+    ASSERT_TRUE(buffer->Push(5));
+    ASSERT_EQ(buffer->Pop(), 5);
+    ASSERT_EQ(buffer->Pop(), std::nullopt);
+}
+
+TEST(Numa_Stress, PinnedProducerAndConsumerTest)
+{
+    constexpr int iterations = 100000;
+
+    const auto cpus = numa::Cpus();
+    const auto producerCpu = cpus.front();
+    const auto consumerCpu = cpus.back();
+
+    using RingBuffer = lockfree::SPSCRingBuffer<int, BufferSize, numa::NodeAllocator<int>, numa::kPageSize>;
+    static_assert(alignof(RingBuffer) == numa::kPageSize && sizeof(RingBuffer) >= 2 * numa::kPageSize);
+
+    auto buffer = numa::MakeOnNode<RingBuffer>(producerCpu.node, numa::NodeAllocator<int>(consumerCpu.node));
+    // The consumer's head lives on the first page.
+    numa::BindToNode(buffer.get(), numa::kPageSize, consumerCpu.node);
+
+    long long sum = 0;
+    std::jthread consumer([&buffer, &sum, consumerCpu]()
+    {
+        numa::PinCurrentThread(consumerCpu.id);
+        for (int i = 0; i < iterations; ++i)
+        {
+            std::optional<int> value;
+            while (!(value = buffer->Pop())) {}
+            sum += *value;
+        }
+    });
+
+    std::jthread producer([&buffer, producerCpu]()
+    {
+        numa::PinCurrentThread(producerCpu.id);
+        for (int i = 0; i < iterations; ++i)
+        {
+            while (!buffer->Push(i)) {}
+        }
+    });
+
+    producer.join();
+    consumer.join();
+
+    ASSERT_EQ(sum, iterations * (iterations - 1LL) / 2);
+}
@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+
+#include <OverwritingRingBuffer.h>
+
+#include <thread>
+#include <vector>
+
+namespace
+{
+    constexpr std::size_t BufferSize = 64;
+    template <class T>
+    using RingBuffer = lockfree::OverwritingRingBuffer<T, BufferSize>;
+}
+
+TEST(OverwritingRingBuffer_Unit, PopEmptyReturnsStdNulloptTest)
+{
+    RingBuffer<int> buffer;
+    ASSERT_EQ(buffer.Pop(), std::nullopt);
+}
+
+TEST(OverwritingRingBuffer_Unit, EntriesCarrySequenceNumbersTest)
+{
+    RingBuffer<int> buffer;
+    for (int i = 0; i < 10; ++i)
+    {
+        buffer.Push(i * 10);
+    }
+
+    for (int i = 0; i < 10; ++i)
+    {
+        const auto entry = buffer.Pop();
+        ASSERT_TRUE(entry.has_value());
+        ASSERT_EQ(entry->sequence, static_cast<uint64_t>(i));
+        ASSERT_EQ(entry->value, i * 10);
+    }
+    ASSERT_EQ(buffer.Pop(), std::nullopt);
+    ASSERT_EQ(buffer.Overwritten(), 0u);
+}
+
+TEST(OverwritingRingBuffer_Unit, FullBufferOverwritesOldestTest)
+{
+    constexpr int extra = 10;
+
+    RingBuffer<int> buffer;
+    for (int i = 0; i < static_cast<int>(BufferSize) + extra; ++i)
+    {
+        buffer.Push(i);
+    }
+
+    for (int i = extra; i < static_cast<int>(BufferSize) + extra; ++i)
+    {
+        const auto entry = buffer.Pop();
+        ASSERT_TRUE(entry.has_value());
+        ASSERT_EQ(entry->sequence, static_cast<uint64_t>(i));
+        ASSERT_EQ(entry->value, i);
+    }
+    ASSERT_EQ(buffer.Pop(), std::nullopt);
+    ASSERT_EQ(buffer.Pushed(), BufferSize + extra);
+    ASSERT_EQ(buffer.Overwritten(), static_cast<uint64_t>(extra));
+}
+
+TEST(OverwritingRingBuffer_Stress, ConsumerSeesOnlyWholeEntriesTest)
+{
+    constexpr long long iterations = 200000;
+    constexpr int producersAmount = 3;
+
+    struct Record
+    {
+        long long producer;
+        long long counter;
+        long long check;
+    };
+
+    RingBuffer<Record> buffer;
+    std::atomic<int> producersDone = 0;
+
+    std::vector<std::jthread> producers;
+    for (int p = 0; p < producersAmount; ++p)
+    {
+        producers.emplace_back([&buffer, &producersDone, p]()
+        {
+            for (long long i = 0; i < iterations; ++i)
+            {
+                buffer.Push(Record{p, i, p * iterations + i});
+            }
+            producersDone.fetch_add(1);
+        });
+    }
+
+    uint64_t popped = 0;
+    std::optional<uint64_t> last;
+    auto drain = [&]()
+    {
+        while (auto entry = buffer.Pop())
+        {
+            ASSERT_EQ(entry->value.check, entry->value.producer * iterations + entry->value.counter);
+            if (last)
+            {
+                ASSERT_GT(entry->sequence, *last);
+            }
+            last = entry->sequence;
+            ++popped;
+        }
+    };
+
+    while (producersDone.load() < producersAmount)
+    {
+        drain();
+    }
+    drain();
+
+    ASSERT_EQ(popped + buffer.Overwritten(), buffer.Pushed());
+    ASSERT_EQ(buffer.Pushed(), static_cast<uint64_t>(iterations * producersAmount));
+}
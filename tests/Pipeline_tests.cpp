@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+
+#include <Pipeline.h>
+
+#include <memory>
+#include <string>
+
+TEST(Pipeline_Unit, SingleSinkReceivesEverythingTest)
+{
+    std::vector<int> received;
+    {
+        auto pipeline = pipeline::Builder<int>()
+            .Sink("emit", [&received](int value) { received.push_back(value); });
+
+        for (int i = 0; i < 100; ++i)
+        {
+            pipeline.Push(i);
+        }
+    }
+
+    ASSERT_EQ(received.size(), 100u);
+    for (int i = 0; i < 100; ++i)
+    {
+        ASSERT_EQ(received[i], i);
+    }
+}
+
+TEST(Pipeline_Unit, TypedStagesPreserveOrderTest)
+{
+    std::vector<std::string> received;
+    {
+        auto pipeline = pipeline::Builder<int>()
+            .Then("double", [](int value) { return value * 2; })
+            .Then("format", [](int value) { return std::to_string(value); })
+            .Sink("emit", [&received](std::string value) { received.push_back(std::move(value)); });
+
+        for (int i = 0; i < 1000; ++i)
+        {
+            pipeline.Push(i);
+        }
+    }
+
+    ASSERT_EQ(received.size(), 1000u);
+    for (int i = 0; i < 1000; ++i)
+    {
+        ASSERT_EQ(received[i], std::to_string(i * 2));
+    }
+}
+
+TEST(Pipeline_Unit, CheapStagesAreFusedTest)
+{
+    auto pipeline = pipeline::Builder<int>()
+        .Then("parse", [](int value) { return value + 1; })
+        .Then("tag", [](int value) { return value * 2; }, {.cheap = true})
+        .Then("enrich", [](int value) { return value - 1; })
+        .Sink("emit", [](int) {}, {.cheap = true});
+
+    for (int i = 0; i < 10; ++i)
+    {
+        pipeline.Push(i);
+    }
+    pipeline.Close();
+    pipeline.Wait();
+
+    const auto metrics = pipeline.Metrics();
+    ASSERT_EQ(metrics.size(), 4u);
+    ASSERT_EQ(metrics[0].segment, metrics[1].segment);
+    ASSERT_EQ(metrics[2].segment, metrics[3].segment);
+    ASSERT_NE(metrics[1].segment, metrics[2].segment);
+    for (const auto& stage : metrics)
+    {
+        ASSERT_EQ(stage.processed, 10u);
+        ASSERT_EQ(stage.queued, 0u);
+    }
+}
+
+TEST(Pipeline_Unit, MoveOnlyElementsTest)
+{
+    int sum = 0;
+    {
+        auto pipeline = pipeline::Builder<std::unique_ptr<int>>()
+            .Then("increment", [](std::unique_ptr<int> value) { ++*value; return value; })
+            .Sink("emit", [&sum](std::unique_ptr<int> value) { sum += *value; });
+
+        for (int i = 0; i < 10; ++i)
+        {
+            pipeline.Push(std::make_unique<int>(i));
+        }
+    }
+
+    ASSERT_EQ(sum, 55);
+}
+
+TEST(Pipeline_Stress, ParallelStageProcessesEverythingTest)
+{
+    constexpr long long iterations = 100000;
+
+    std::atomic<long long> sum = 0;
+    long long sinkSum = 0;
+    {
+        auto pipeline = pipeline::Builder<long long, 256>()
+            .Then("parse", [](long long value) { return value; })
+            .Then("enrich", [&sum](long long value) { sum.fetch_add(value, std::memory_order_relaxed); return value * 2; }, {.parallelism = 3, .batch = 8})
+            .Sink("emit", [&sinkSum](long long value) { sinkSum += value; });
+
+        for (long long i = 0; i < iterations; ++i)
+        {
+            pipeline.Push(i);
+        }
+        pipeline.Close();
+        pipeline.Wait();
+
+        for (const auto& stage : pipeline.Metrics())
+        {
+            ASSERT_EQ(stage.processed, static_cast<std::size_t>(iterations));
+        }
+    }
+
+    ASSERT_EQ(sum, iterations * (iterations - 1) / 2);
+    ASSERT_EQ(sinkSum, iterations * (iterations - 1));
+}
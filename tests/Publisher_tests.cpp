@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+
+#include <Publisher.h>
+
+#include <map>
+#include <string>
+#include <thread>
+
+namespace
+{
+    struct Config
+    {
+        explicit Config(int version, std::atomic<int>* alive = nullptr)
+            : version(version)
+            , alive(alive)
+        {
+            if (alive)
+            {
+                alive->fetch_add(1);
+            }
+        }
+
+        ~Config()
+        {
+            if (alive)
+            {
+                alive->fetch_sub(1);
+            }
+        }
+
+        int version;
+        std::atomic<int>* alive;
+    };
+}
+
+TEST(Publisher_Unit, ReadReturnsInitialSnapshotTest)
+{
+    lockfree::Publisher<std::map<std::string, int>> publisher(std::make_unique<const std::map<std::string, int>>(std::map<std::string, int>{{"limit", 5}}));
+    ASSERT_EQ(publisher.Read()->at("limit"), 5);
+}
+
+TEST(Publisher_Unit, ReadSeesLatestPublishTest)
+{
+    lockfree::Publisher<Config> publisher(std::make_unique<const Config>(1));
+    publisher.Emplace(2);
+    ASSERT_EQ(publisher.Read()->version, 2);
+}
+
+TEST(Publisher_Unit, HeldSnapshotSurvivesPublishTest)
+{
+    std::atomic<int> alive = 0;
+    lockfree::Publisher<Config> publisher(std::make_unique<const Config>(1, &alive));
+    {
+        auto snapshot = publisher.Read();
+        publisher.Emplace(2, &alive);
+        publisher.Emplace(3, &alive);
+
+        ASSERT_EQ(snapshot->version, 1);
+        ASSERT_EQ(alive, 3);
+        ASSERT_EQ(publisher.Pending(), 2u);
+
+        auto nested = publisher.Read();
+        ASSERT_EQ(nested->version, 3);
+    }
+
+    publisher.Synchronize();
+    ASSERT_EQ(publisher.Pending(), 0u);
+    ASSERT_EQ(alive, 1);
+}
+
+TEST(Publisher_Unit, SnapshotsAreFreedWithoutReadersTest)
+{
+    std::atomic<int> alive = 0;
+    {
+        lockfree::Publisher<Config> publisher(std::make_unique<const Config>(1, &alive));
+        for (int i = 2; i < 10; ++i)
+        {
+            publisher.Emplace(i, &alive);
+            ASSERT_EQ(publisher.Pending(), 0u);
+        }
+        ASSERT_EQ(alive, 1);
+    }
+    ASSERT_EQ(alive, 0);
+}
+
+TEST(Publisher_Stress, ReadersNeverSeeFreedSnapshotsTest)
+{
+    constexpr int iterations = 20000;
+    constexpr int readersAmount = 3;
+
+    std::atomic<int> alive = 0;
+    lockfree::Publisher<Config> publisher(std::make_unique<const Config>(0, &alive));
+    std::atomic<bool> done = false;
+    std::atomic<bool> broken = false;
+
+    std::vector<std::thread> readers;
+    for (int i = 0; i < readersAmount; ++i)
+    {
+        readers.emplace_back([&publisher, &done, &broken]()
+        {
+            int last = 0;
+            while (!done.load(std::memory_order_relaxed))
+            {
+                auto snapshot = publisher.Read();
+                const auto version = snapshot->version;
+                std::this_thread::yield();
+                if (snapshot->version != version || version < last)
+                {
+                    broken = true;
+                }
+                last = version;
+            }
+        });
+    }
+
+    for (int i = 1; i <= iterations; ++i)
+    {
+        publisher.Emplace(i, &alive);
+    }
+    done = true;
+
+    for (auto& reader : readers)
+    {
+        reader.join();
+    }
+
+    publisher.Synchronize();
+    ASSERT_FALSE(broken);
+    ASSERT_EQ(alive, 1);
+    ASSERT_EQ(publisher.Read()->version, iterations);
+}
@@ -0,0 +1,157 @@
+#include <gtest/gtest.h>
+
+#include <BatchedSPSCRingBuffer.h>
+#include <BlockingRingBuffer.h>
+#include <Channels.h>
+#include <ConflatingQueue.h>
+#include <Debug.h>
+#include <IntrusiveMPSCQueue.h>
+#include <Locks.h>
+#include <MPMCRingBuffer.h>
+#include <MSQueue.h>
+#include <OverwritingRingBuffer.h>
+#include <Queue.h>
+#include <SPSCRingBuffer.h>
+#include <SPSCUnboundedQueue.h>
+#include <UnboundedStack.h>
+#include <WaitFreeQueue.h>
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <type_traits>
+
+namespace
+{
+    constexpr std::size_t BufferSize = 64;
+
+    struct Element : lockfree::MPSCQueueHook
+    {
+    };
+
+    template <queue::Queue Q>
+    void ExpectFifo(Q& queue)
+    {
+        for (int i = 0; i < static_cast<int>(BufferSize); ++i)
+        {
+            ASSERT_TRUE(queue::TryPush(queue, i));
+        }
+        for (int i = 0; i < static_cast<int>(BufferSize); ++i)
+        {
+            ASSERT_EQ(queue.Pop(), i);
+        }
+        ASSERT_EQ(queue.Pop(), std::nullopt);
+    }
+}
+
+static_assert(queue::BoundedQueue<lockfree::SPSCRingBuffer<int, BufferSize>>);
+static_assert(queue::BoundedQueue<lockfree::BatchedSPSCRingBuffer<int, BufferSize>>);
+static_assert(queue::BoundedQueue<lockfree::MPMCRingBuffer<std::string, BufferSize>>);
+static_assert(queue::BoundedQueue<blocking::BlockingRingBuffer<int, BufferSize>>);
+static_assert(queue::BoundedQueue<blocking::BlockingRingBuffer<int, BufferSize, blocking::TicketLock>>);
+static_assert(queue::UnboundedQueue<lockfree::MSQueue<std::unique_ptr<int>>>);
+static_assert(queue::UnboundedQueue<lockfree::SPSCUnboundedQueue<int>>);
+static_assert(queue::UnboundedQueue<lockfree::UnboundedStack<int>>);
+static_assert(queue::UnboundedQueue<lockfree::WaitFreeQueue<int>>);
+
+static_assert(!queue::Queue<lockfree::IntrusiveMPSCQueue<Element>>);
+static_assert(!queue::Queue<lockfree::ConflatingQueue<int, BufferSize>>);
+static_assert(!queue::Queue<lockfree::OverwritingRingBuffer<int, BufferSize>>);
+static_assert(!queue::Queue<int>);
+
+using lockfree::Bounded;
+using lockfree::Channel;
+using lockfree::Consumers;
+using lockfree::Producers;
+using lockfree::Unbounded;
+
+static_assert(std::is_same_v<Channel<int, Producers::Single, Consumers::Single, Bounded<BufferSize>>, lockfree::SPSCRingBuffer<int, BufferSize>>);
+static_assert(std::is_same_v<Channel<int, Producers::Multi, Consumers::Single, Bounded<BufferSize>>, lockfree::MPMCRingBuffer<int, BufferSize>>);
+static_assert(std::is_same_v<Channel<int, Producers::Single, Consumers::Multi, Bounded<BufferSize>>, lockfree::MPMCRingBuffer<int, BufferSize>>);
+static_assert(std::is_same_v<Channel<int, Producers::Multi, Consumers::Multi, Bounded<BufferSize>>, lockfree::MPMCRingBuffer<int, BufferSize>>);
+static_assert(std::is_same_v<Channel<int, Producers::Single, Consumers::Single, Unbounded>, lockfree::SPSCUnboundedQueue<int>>);
+static_assert(std::is_same_v<Channel<int, Producers::Multi, Consumers::Single, Unbounded>, lockfree::WaitFreeQueue<int>>);
+static_assert(std::is_same_v<Channel<int, Producers::Multi, Consumers::Multi, Unbounded>, lockfree::WaitFreeQueue<int>>);
+
+TEST(Queue_Unit, EveryChannelIsFifoTest)
+{
+    Channel<int, Producers::Single, Consumers::Single, Bounded<BufferSize>> spsc;
+    Channel<int, Producers::Multi, Consumers::Multi, Bounded<BufferSize>> mpmc;
+    Channel<int, Producers::Single, Consumers::Single, Unbounded> spscUnbounded;
+    Channel<int, Producers::Multi, Consumers::Multi, Unbounded> mpmcUnbounded;
+
+    ExpectFifo(spsc);
+    ExpectFifo(mpmc);
+    ExpectFifo(spscUnbounded);
+    ExpectFifo(mpmcUnbounded);
+}
+
+TEST(Queue_Unit, TryPushReportsFullBoundedQueueTest)
+{
+    lockfree::SPSCRingBuffer<int, BufferSize> bounded;
+    for (std::size_t i = 0; i < BufferSize; ++i)
+    {
+        ASSERT_TRUE(queue::TryPush(bounded, 0));
+    }
+    ASSERT_FALSE(queue::TryPush(bounded, 0));
+}
+
+TEST(Queue_Unit, SPSCUnboundedQueueMovesOnlyElementsTest)
+{
+    lockfree::SPSCUnboundedQueue<std::unique_ptr<int>> queue;
+    queue.Push(std::make_unique<int>(5));
+    auto value = queue.Pop();
+    ASSERT_TRUE(value.has_value());
+    ASSERT_EQ(**value, 5);
+    ASSERT_EQ(queue.Pop(), std::nullopt);
+}
+
+#ifndef NDEBUG
+TEST(Queue_Unit, ExclusiveUseCatchesOverlappingUsersTest)
+{
+    ASSERT_DEATH(
+    {
+        debug::ExclusiveUse use;
+        [[maybe_unused]] const auto first = use.Enter();
+        [[maybe_unused]] const auto second = use.Enter();
+    }, "two threads at once");
+}
+
+TEST(Queue_Unit, ExclusiveUseAllowsHandOverTest)
+{
+    debug::ExclusiveUse use;
+    {
+        [[maybe_unused]] const auto guard = use.Enter();
+    }
+    std::thread([&use]()
+    {
+        [[maybe_unused]] const auto guard = use.Enter();
+    }).join();
+}
+#endif
+
+TEST(Queue_Stress, SPSCUnboundedQueueDeliversEverythingInOrderTest)
+{
+    constexpr int iterations = 1000000;
+
+    Channel<int, Producers::Single, Consumers::Single, Unbounded> channel;
+    std::thread producer([&channel]()
+    {
+        for (int i = 0; i < iterations; ++i)
+        {
+            channel.Push(i);
+        }
+    });
+
+    for (int expected = 0; expected < iterations;)
+    {
+        if (auto value = channel.Pop())
+        {
+            ASSERT_EQ(*value, expected);
+            ++expected;
+        }
+    }
+    producer.join();
+
+    ASSERT_EQ(channel.Pop(), std::nullopt);
+}
@@ -1,7 +1,10 @@
 #include <gtest/gtest.h>
 
 #include <SPSCRingBuffer.h>
+#include <numeric>
+#include <span>
 #include <thread>
+#include <vector>
 
 namespace
 {
@@ -52,6 +55,23 @@ TEST(SPSCRingBuffer_Unit, CannotOverflowTest) {
     ASSERT_FALSE(buffer.Push(0));
 }
 
+TEST(SPSCRingBuffer_Unit, PushBatchTakesWhatFitsTest) {
+    RingBuffer<int> queue;
+    std::vector<int> values(BufferSize + 10);
+    std::iota(values.begin(), values.end(), 0);
+
+    ASSERT_EQ(queue.PushBatch(std::span(values).first(10)), 10u);
+    ASSERT_EQ(queue.PushBatch(std::span(values).subspan(10)), BufferSize - 10);
+    ASSERT_TRUE(queue.Full());
+    ASSERT_EQ(queue.PushBatch(std::span(values).last(10)), 0u);
+
+    for (int i = 0; i < static_cast<int>(BufferSize); ++i)
+    {
+        ASSERT_EQ(queue.Pop(), i);
+    }
+    ASSERT_EQ(queue.Pop(), std::nullopt);
+}
+
 TEST(SPSCRingBuffer_Stress, ConcurrentPushAndPopReturnsAllElementsTest) {
     constexpr int iterations = 1000000;
 
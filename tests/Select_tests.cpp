@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+
+#include <BlockingRingBuffer.h>
+#include <MPMCRingBuffer.h>
+#include <MSQueue.h>
+#include <SPSCRingBuffer.h>
+#include <Select.h>
+
+#include <string>
+#include <thread>
+
+namespace
+{
+    constexpr std::size_t BufferSize = 64;
+}
+
+TEST(Select_Unit, TrySelectOnEmptyQueuesReturnsStdNulloptTest)
+{
+    mux::EventCount event;
+    lockfree::SPSCRingBuffer<int, BufferSize> first;
+    lockfree::MPMCRingBuffer<int, BufferSize> second;
+    mux::Selector selector(event, mux::Fairness::RoundRobin, first, second);
+
+    ASSERT_EQ(selector.TrySelect(), std::nullopt);
+}
+
+TEST(Select_Unit, ResultIndexIsQueueIndexTest)
+{
+    mux::EventCount event;
+    lockfree::SPSCRingBuffer<int, BufferSize> numbers;
+    blocking::BlockingRingBuffer<std::string, BufferSize> strings;
+    mux::Selector selector(event, mux::Fairness::Priority, numbers, strings);
+
+    strings.Push("control");
+    auto result = selector.TrySelect();
+    ASSERT_TRUE(result.has_value());
+    ASSERT_EQ(result->index(), 1u);
+    ASSERT_EQ(std::get<1>(*result), "control");
+}
+
+TEST(Select_Unit, PriorityAlwaysDrainsFirstQueueFirstTest)
+{
+    mux::EventCount event;
+    lockfree::MPMCRingBuffer<int, BufferSize> high;
+    lockfree::MPMCRingBuffer<int, BufferSize> low;
+    mux::Selector selector(event, mux::Fairness::Priority, high, low);
+
+    high.Push(1);
+    high.Push(2);
+    low.Push(3);
+
+    ASSERT_EQ(selector.TrySelect()->index(), 0u);
+    ASSERT_EQ(selector.TrySelect()->index(), 0u);
+    ASSERT_EQ(selector.TrySelect()->index(), 1u);
+}
+
+TEST(Select_Unit, RoundRobinAlternatesBetweenReadyQueuesTest)
+{
+    mux::EventCount event;
+    lockfree::MPMCRingBuffer<int, BufferSize> first;
+    lockfree::MPMCRingBuffer<int, BufferSize> second;
+    mux::Selector selector(event, mux::Fairness::RoundRobin, first, second);
+
+    first.Push(1);
+    first.Push(2);
+    second.Push(3);
+    second.Push(4);
+
+    ASSERT_EQ(selector.TrySelect()->index(), 0u);
+    ASSERT_EQ(selector.TrySelect()->index(), 1u);
+    ASSERT_EQ(selector.TrySelect()->index(), 0u);
+    ASSERT_EQ(selector.TrySelect()->index(), 1u);
+    ASSERT_EQ(selector.TrySelect(), std::nullopt);
+}
+
+TEST(Select_Unit, PushAndNotifyWorksWithUnboundedQueuesTest)
+{
+    mux::EventCount event;
+    lockfree::MSQueue<int> queue;
+    mux::Selector selector(event, mux::Fairness::RoundRobin, queue);
+
+    ASSERT_TRUE(mux::PushAndNotify(queue, event, 5));
+    ASSERT_EQ(std::get<0>(selector.Select()), 5);
+}
+
+TEST(Select_Stress, ParkedConsumerReceivesEveryElementTest)
+{
+    constexpr int iterations = 10000;
+
+    mux::EventCount event;
+    lockfree::SPSCRingBuffer<int, BufferSize> control;
+    lockfree::MPMCRingBuffer<int, BufferSize> data;
+    blocking::BlockingRingBuffer<int, BufferSize> heartbeat;
+
+    std::array<int, 3> received{};
+    std::thread consumer([&]()
+    {
+        mux::Selector selector(event, mux::Fairness::RoundRobin, control, data, heartbeat);
+        for (int i = 0; i < iterations * 3; ++i)
+        {
+            ++received[selector.Select().index()];
+        }
+    });
+
+    auto produce = [&event](auto& queue)
+    {
+        return std::thread([&event, &queue]()
+        {
+            for (int i = 0; i < iterations; ++i)
+            {
+                while (!mux::PushAndNotify(queue, event, i)) {}
+                if (i % 1000 == 0)
+                {
+                    using namespace std::chrono_literals;
+                    std::this_thread::sleep_for(100us);
+                }
+            }
+        });
+    };
+
+    auto controlProducer = produce(control);
+    auto dataProducer = produce(data);
+    auto heartbeatProducer = produce(heartbeat);
+
+    controlProducer.join();
+    dataProducer.join();
+    heartbeatProducer.join();
+    consumer.join();
+
+    ASSERT_EQ(received, (std::array<int, 3>{iterations, iterations, iterations}));
+}
@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+
+#include <SeqLock.h>
+#include <thread>
+
+namespace
+{
+    struct Quote
+    {
+        long long bid = 0;
+        long long ask = 0;
+        long long size = 0;
+        char venue = 'A';
+    };
+}
+
+TEST(SeqLock_Unit, DefaultCtorHoldsDefaultValueTest)
+{
+    lockfree::SeqLock<int> lock;
+    ASSERT_EQ(lock.Load(), 0);
+}
+
+TEST(SeqLock_Unit, LoadReturnsLastStoreTest)
+{
+    lockfree::SeqLock<Quote> lock(Quote{.bid = 1, .ask = 2, .size = 3, .venue = 'B'});
+    ASSERT_EQ(lock.Load().ask, 2);
+
+    lock.Store(Quote{.bid = 4, .ask = 5, .size = 6, .venue = 'C'});
+    const auto quote = lock.Load();
+    ASSERT_EQ(quote.bid, 4);
+    ASSERT_EQ(quote.ask, 5);
+    ASSERT_EQ(quote.size, 6);
+    ASSERT_EQ(quote.venue, 'C');
+}
+
+TEST(SeqLock_Unit, TryLoadSucceedsWithoutWritersTest)
+{
+    lockfree::SeqLock<Quote> lock;
+    ASSERT_TRUE(lock.TryLoad().has_value());
+}
+
+TEST(SeqLock_Stress, ReadersNeverSeeTornValuesTest)
+{
+    constexpr long long iterations = 200000;
+    constexpr int readersAmount = 3;
+
+    lockfree::SeqLock<Quote> lock(Quote{.bid = 0, .ask = 1, .size = 0, .venue = 'A'});
+    std::atomic<bool> done = false;
+    std::atomic<bool> torn = false;
+
+    std::vector<std::thread> readers;
+    for (int i = 0; i < readersAmount; ++i)
+    {
+        readers.emplace_back([&lock, &done, &torn]()
+        {
+            long long last = 0;
+            while (!done.load(std::memory_order_relaxed))
+            {
+                const auto quote = lock.Load();
+                if (quote.ask != quote.bid + 1 || quote.size != quote.bid * 2 || quote.bid < last)
+                {
+                    torn = true;
+                }
+                last = quote.bid;
+            }
+        });
+    }
+
+    for (long long i = 1; i <= iterations; ++i)
+    {
+        lock.Store(Quote{.bid = i, .ask = i + 1, .size = i * 2, .venue = 'A'});
+    }
+    done = true;
+
+    for (auto& reader : readers)
+    {
+        reader.join();
+    }
+
+    ASSERT_FALSE(torn);
+    ASSERT_EQ(lock.Load().bid, iterations);
+}
@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+
+#include <SlotAllocator.h>
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <set>
+#include <thread>
+#include <vector>
+
+TEST(SlotAllocator_Unit, AllocatesEveryIndexOnceTest)
+{
+    constexpr std::size_t capacity = 200;
+    lockfree::SlotAllocator<capacity> slots;
+    ASSERT_EQ(slots.Available(), capacity);
+
+    std::set<std::size_t> seen;
+    for (std::size_t i = 0; i < capacity; ++i)
+    {
+        const auto index = slots.Allocate();
+        ASSERT_TRUE(index.has_value());
+        ASSERT_LT(*index, capacity);
+        ASSERT_TRUE(seen.insert(*index).second);
+    }
+
+    ASSERT_EQ(slots.Allocate(), std::nullopt);
+    ASSERT_EQ(slots.Available(), 0u);
+}
+
+TEST(SlotAllocator_Unit, FreedSlotIsReusedTest)
+{
+    lockfree::SlotAllocator<64> slots;
+    for (std::size_t i = 0; i < 64; ++i)
+    {
+        slots.Allocate();
+    }
+
+    slots.Free(17);
+    ASSERT_EQ(slots.Allocate(), 17u);
+    ASSERT_EQ(slots.Allocate(), std::nullopt);
+}
+
+TEST(SlotAllocator_Unit, BulkAllocateAndFreeTest)
+{
+    constexpr std::size_t capacity = 130;
+    lockfree::SlotAllocator<capacity> slots;
+
+    std::vector<std::size_t> first(100);
+    ASSERT_EQ(slots.Allocate(first), 100u);
+    std::vector<std::size_t> second(50);
+    ASSERT_EQ(slots.Allocate(second), 30u);
+    ASSERT_EQ(slots.Available(), 0u);
+
+    std::set<std::size_t> seen(first.begin(), first.end());
+    seen.insert(second.begin(), second.begin() + 30);
+    ASSERT_EQ(seen.size(), capacity);
+
+    std::sort(first.begin(), first.end());
+    slots.Free(first);
+    ASSERT_EQ(slots.Available(), 100u);
+}
+
+TEST(SlotAllocator_Unit, TableLargerThanOneSummaryWordTest)
+{
+    constexpr std::size_t capacity = 64 * 64 * 3 + 5;
+    auto slots = std::make_unique<lockfree::SlotAllocator<capacity>>();
+
+    std::vector<std::size_t> indexes(capacity);
+    ASSERT_EQ(slots->Allocate(indexes), capacity);
+    ASSERT_EQ(slots->Allocate(), std::nullopt);
+
+    slots->Free(capacity - 1);
+    ASSERT_EQ(slots->Allocate(), capacity - 1);
+}
+
+TEST(SlotAllocator_Stress, SlotsAreNeverSharedTest)
+{
+    constexpr std::size_t capacity = 256;
+    constexpr int iterations = 100000;
+    constexpr int threadsAmount = 8;
+    constexpr std::size_t batch = 8;
+
+    lockfree::SlotAllocator<capacity> slots;
+    std::array<std::atomic<bool>, capacity> owned{};
+    std::atomic<bool> shared = false;
+    {
+        std::vector<std::jthread> threads;
+        for (int t = 0; t < threadsAmount; ++t)
+        {
+            threads.emplace_back([&, t]()
+            {
+                std::array<std::size_t, batch> held{};
+                for (int i = 0; i < iterations; ++i)
+                {
+                    const auto amount = t % 2 == 0 ? slots.Allocate(std::span(held).first(1 + i % batch)) : slots.Allocate(std::span(held).first(1));
+                    for (std::size_t k = 0; k < amount; ++k)
+                    {
+                        if (owned[held[k]].exchange(true))
+                        {
+                            shared = true;
+                        }
+                    }
+                    for (std::size_t k = 0; k < amount; ++k)
+                    {
+                        owned[held[k]].store(false);
+                    }
+                    std::sort(held.begin(), held.begin() + amount);
+                    slots.Free(std::span<const std::size_t>(held.data(), amount));
+                }
+            });
+        }
+    }
+
+    ASSERT_FALSE(shared);
+    ASSERT_EQ(slots.Available(), capacity);
+}
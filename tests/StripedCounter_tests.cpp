@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+
+#include <StripedCounter.h>
+
+#include <thread>
+#include <vector>
+
+TEST(StripedCounter_Unit, CounterSumsAddsTest)
+{
+    lockfree::StripedCounter counter;
+    ASSERT_EQ(counter.Load(), 0u);
+
+    counter.Increment();
+    counter.Add(41);
+    ASSERT_EQ(counter.Load(), 42u);
+
+    counter.Reset();
+    ASSERT_EQ(counter.Load(), 0u);
+}
+
+TEST(StripedCounter_Unit, GaugeGoesUpAndDownTest)
+{
+    lockfree::StripedGauge gauge;
+    gauge.Increment();
+    gauge.Add(10);
+    gauge.Decrement();
+    ASSERT_EQ(gauge.Load(), 10);
+
+    gauge.Add(-15);
+    ASSERT_EQ(gauge.Load(), -5);
+}
+
+TEST(StripedCounter_Unit, MinMaxStartAtIdentityTest)
+{
+    lockfree::StripedMax<int> max;
+    lockfree::StripedMin<double> min;
+    ASSERT_EQ(max.Load(), std::numeric_limits<int>::lowest());
+    ASSERT_EQ(min.Load(), std::numeric_limits<double>::max());
+
+    for (int value : {3, -7, 12, 5})
+    {
+        max.Record(value);
+        min.Record(value);
+    }
+    ASSERT_EQ(max.Load(), 12);
+    ASSERT_EQ(min.Load(), -7.0);
+
+    max.Reset();
+    ASSERT_EQ(max.Load(), std::numeric_limits<int>::lowest());
+}
+
+TEST(StripedCounter_Stress, ConcurrentUpdatesAreNotLostTest)
+{
+    constexpr int iterations = 100000;
+    constexpr int threadsAmount = 24;
+
+    lockfree::StripedCounter<4> counter;
+    lockfree::StripedGauge<4> gauge;
+    lockfree::StripedMax<int, 4> max;
+    lockfree::StripedMin<int, 4> min;
+    {
+        std::vector<std::jthread> threads;
+        for (int t = 0; t < threadsAmount; ++t)
+        {
+            threads.emplace_back([&, t]()
+            {
+                for (int i = 0; i < iterations; ++i)
+                {
+                    counter.Increment();
+                    gauge.Add(t % 2 == 0 ? 1 : -1);
+                    max.Record(t * iterations + i);
+                    min.Record(-(t * iterations + i));
+                }
+            });
+        }
+    }
+
+    ASSERT_EQ(counter.Load(), static_cast<std::size_t>(iterations) * threadsAmount);
+    ASSERT_EQ(gauge.Load(), 0);
+    ASSERT_EQ(max.Load(), threadsAmount * iterations - 1);
+    ASSERT_EQ(min.Load(), -(threadsAmount * iterations - 1));
+}
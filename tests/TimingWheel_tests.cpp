@@ -0,0 +1,246 @@
+#include <gtest/gtest.h>
+
+#include <TimingWheel.h>
+
+#include <array>
+#include <atomic>
+#include <optional>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    using namespace std::chrono_literals;
+
+    const auto Start = timer::Clock::time_point{};
+
+    timer::Clock::time_point At(timer::Clock::duration offset)
+    {
+        return Start + offset;
+    }
+}
+
+TEST(TimingWheel_Unit, TaskRunsOnlyOnceDueTest)
+{
+    timer::TimingWheel wheel(1ms, Start);
+    int fired = 0;
+    wheel.Schedule(10ms, [&fired]() { ++fired; });
+
+    ASSERT_EQ(wheel.Advance(At(9ms)), 0u);
+    ASSERT_EQ(fired, 0);
+    ASSERT_EQ(wheel.Advance(At(10ms)), 1u);
+    ASSERT_EQ(fired, 1);
+    ASSERT_EQ(wheel.Advance(At(1000ms)), 0u);
+    ASSERT_EQ(wheel.Pending(), 0u);
+}
+
+TEST(TimingWheel_Unit, TasksRunInExpiryOrderTest)
+{
+    timer::TimingWheel wheel(1ms, Start);
+    std::vector<int> order;
+    wheel.Schedule(300ms, [&order]() { order.push_back(3); });
+    wheel.Schedule(5ms, [&order]() { order.push_back(1); });
+    wheel.Schedule(70'000ms, [&order]() { order.push_back(4); });
+    wheel.Schedule(256ms, [&order]() { order.push_back(2); });
+
+    for (int ms = 1; ms <= 70'000; ++ms)
+    {
+        wheel.Advance(At(std::chrono::milliseconds(ms)));
+    }
+
+    ASSERT_EQ(order, (std::vector<int>{1, 2, 3, 4}));
+}
+
+TEST(TimingWheel_Unit, LongTimeoutsCascadeToExactTickTest)
+{
+    timer::TimingWheel wheel(1ms, Start);
+
+    // Spread over the first three levels, with some right on digit boundaries.
+    std::mt19937 random(42);
+    std::vector<uint64_t> delays = {1, 255, 256, 257, 65'535, 65'536, 65'537, 16'777'216};
+    for (int i = 0; i < 200; ++i)
+    {
+        delays.push_back(std::uniform_int_distribution<uint64_t>(1, 20'000'000)(random));
+    }
+
+    std::vector<uint64_t> firedAt(delays.size(), 0);
+    uint64_t now = 0;
+    for (std::size_t i = 0; i < delays.size(); ++i)
+    {
+        wheel.Schedule(std::chrono::milliseconds(delays[i]), [&firedAt, &now, i]() { firedAt[i] = now; });
+    }
+
+    // Big jumps: every tick in between is still processed in order.
+    for (now = 1'000; now <= 20'000'000; now += 1'000)
+    {
+        wheel.Advance(At(std::chrono::milliseconds(now)));
+    }
+
+    for (std::size_t i = 0; i < delays.size(); ++i)
+    {
+        ASSERT_EQ(firedAt[i], (delays[i] + 999) / 1'000 * 1'000) << "delay " << delays[i];
+    }
+}
+
+TEST(TimingWheel_Unit, CancelPendingTimerTest)
+{
+    timer::TimingWheel wheel(1ms, Start);
+    int fired = 0;
+    const auto first = wheel.Schedule(10ms, [&fired]() { ++fired; });
+    const auto second = wheel.Schedule(1'000'000ms, [&fired]() { ++fired; });
+    wheel.Schedule(10ms, [&fired]() { fired += 10; });
+
+    ASSERT_TRUE(wheel.Cancel(first));
+    ASSERT_FALSE(wheel.Cancel(first));
+    ASSERT_TRUE(wheel.Cancel(second));
+    ASSERT_EQ(wheel.Pending(), 1u);
+
+    wheel.Advance(At(2'000'000ms));
+    ASSERT_EQ(fired, 10);
+}
+
+TEST(TimingWheel_Unit, StaleIdDoesNotCancelReusedNodeTest)
+{
+    timer::TimingWheel wheel(1ms, Start);
+    int fired = 0;
+    const auto stale = wheel.Schedule(1ms, []() {});
+    wheel.Advance(At(1ms));
+
+    wheel.Schedule(1ms, [&fired]() { ++fired; });
+    ASSERT_FALSE(wheel.Cancel(stale));
+    wheel.Advance(At(2ms));
+    ASSERT_EQ(fired, 1);
+}
+
+TEST(TimingWheel_Unit, PostedTimerCanBeCancelledTest)
+{
+    timer::TimingWheel wheel(1ms, Start);
+    int fired = 0;
+    std::optional<timer::TimerId> first;
+    std::optional<timer::TimerId> second;
+    std::optional<timer::TimerId> third;
+    std::jthread([&]()
+    {
+        first = wheel.Post(5ms, [&fired]() { ++fired; });
+        second = wheel.PostEvery(5ms, [&fired]() { fired += 10; });
+        third = wheel.Post(5ms, [&fired]() { fired += 100; });
+        wheel.PostCancel(*second);
+    }).join();
+
+    ASSERT_TRUE(first && second && third);
+    ASSERT_NE(*first, *third);
+
+    // Still in the inbox when cancelled.
+    ASSERT_TRUE(wheel.Cancel(*third));
+    ASSERT_FALSE(wheel.Cancel(*third));
+
+    wheel.Advance(At(100ms));
+    ASSERT_EQ(fired, 1);
+    ASSERT_FALSE(wheel.Cancel(*first));
+    ASSERT_FALSE(wheel.Cancel(*second));
+    ASSERT_EQ(wheel.Pending(), 0u);
+}
+
+TEST(TimingWheel_Unit, PeriodicTimerCancelsItselfTest)
+{
+    timer::TimingWheel wheel(1ms, Start);
+    int fired = 0;
+    timer::TimerId id = 0;
+    id = wheel.ScheduleEvery(10ms, [&]()
+    {
+        if (++fired == 5)
+        {
+            wheel.Cancel(id);
+        }
+    });
+
+    for (int ms = 1; ms <= 1'000; ++ms)
+    {
+        wheel.Advance(At(std::chrono::milliseconds(ms)));
+        if (ms == 30)
+        {
+            ASSERT_EQ(fired, 3);
+        }
+    }
+
+    ASSERT_EQ(fired, 5);
+    ASSERT_EQ(wheel.Pending(), 0u);
+}
+
+TEST(TimingWheel_Unit, OneShotCannotCancelItselfTest)
+{
+    timer::TimingWheel wheel(1ms, Start);
+    bool cancelled = true;
+    timer::TimerId id = 0;
+    id = wheel.Schedule(5ms, [&]()
+    {
+        cancelled = wheel.Cancel(id);
+    });
+
+    ASSERT_EQ(wheel.Advance(At(10ms)), 1u);
+    ASSERT_FALSE(cancelled);
+    ASSERT_FALSE(wheel.Cancel(id));
+    ASSERT_EQ(wheel.Pending(), 0u);
+}
+
+TEST(TimingWheel_Unit, TasksMayScheduleAndCancelTest)
+{
+    timer::TimingWheel wheel(1ms, Start);
+    int fired = 0;
+    int rescheduled = 0;
+
+    // Both expire in the same tick and whichever runs first cancels the other.
+    std::array<timer::TimerId, 2> ids{};
+    for (std::size_t i = 0; i < ids.size(); ++i)
+    {
+        ids[i] = wheel.Schedule(5ms, [&, other = 1 - i]()
+        {
+            ++fired;
+            ASSERT_TRUE(wheel.Cancel(ids[other]));
+            for (int j = 0; j < 100; ++j)
+            {
+                wheel.Schedule(5ms, [&rescheduled]() { ++rescheduled; });
+            }
+        });
+    }
+
+    wheel.Advance(At(5ms));
+    ASSERT_EQ(fired, 1);
+    ASSERT_EQ(rescheduled, 0);
+    wheel.Advance(At(10ms));
+    ASSERT_EQ(rescheduled, 100);
+    ASSERT_EQ(wheel.Pending(), 0u);
+}
+
+TEST(TimingWheel_Stress, PostedTimersFromManyThreadsTest)
+{
+    constexpr int timersPerThread = 10000;
+    constexpr int threadsAmount = 3;
+
+    timer::TimingWheel<1024> wheel(1ms, Start);
+    std::atomic<int> posted = 0;
+    int fired = 0;
+
+    std::vector<std::jthread> threads;
+    for (int t = 0; t < threadsAmount; ++t)
+    {
+        threads.emplace_back([&wheel, &posted, &fired, t]()
+        {
+            for (int i = 0; i < timersPerThread; ++i)
+            {
+                while (!wheel.Post(std::chrono::milliseconds(1 + (i + t) % 500), [&fired]() { ++fired; })) {}
+                posted.fetch_add(1);
+            }
+        });
+    }
+
+    int ms = 0;
+    while (posted.load() < timersPerThread * threadsAmount || wheel.Pending() > 0)
+    {
+        wheel.Advance(At(std::chrono::milliseconds(++ms)));
+    }
+    wheel.Advance(At(std::chrono::milliseconds(ms + 1'000)));
+
+    ASSERT_EQ(fired, timersPerThread * threadsAmount);
+}
@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+
+#include <TripleBuffer.h>
+
+#include <memory>
+#include <string>
+#include <thread>
+
+TEST(TripleBuffer_Unit, NothingPublishedTest)
+{
+    lockfree::TripleBuffer<int> buffer(7);
+    ASSERT_FALSE(buffer.Update());
+    ASSERT_EQ(buffer.Read(), 7);
+    ASSERT_EQ(buffer.Pop(), std::nullopt);
+}
+
+TEST(TripleBuffer_Unit, ReaderSeesOnlyLatestValueTest)
+{
+    lockfree::TripleBuffer<int> buffer;
+    for (int i = 1; i <= 10; ++i)
+    {
+        buffer.Write(i);
+    }
+
+    ASSERT_TRUE(buffer.Update());
+    ASSERT_EQ(buffer.Read(), 10);
+    ASSERT_FALSE(buffer.Update());
+    ASSERT_EQ(buffer.Read(), 10);
+}
+
+TEST(TripleBuffer_Unit, WriteBufferInPlaceTest)
+{
+    lockfree::TripleBuffer<std::string> buffer;
+    buffer.WriteBuffer() = "snapshot";
+    buffer.WriteBuffer() += " 1";
+    buffer.Publish();
+
+    ASSERT_EQ(buffer.Pop(), "snapshot 1");
+    ASSERT_EQ(buffer.Pop(), std::nullopt);
+}
+
+TEST(TripleBuffer_Unit, MoveOnlyValuesTest)
+{
+    lockfree::TripleBuffer<std::unique_ptr<int>> buffer;
+    buffer.Write(std::make_unique<int>(1));
+    buffer.Write(std::make_unique<int>(2));
+
+    auto value = buffer.Pop();
+    ASSERT_TRUE(value.has_value());
+    ASSERT_EQ(**value, 2);
+}
+
+TEST(TripleBuffer_Stress, ReaderNeverSeesTornOrOlderValuesTest)
+{
+    constexpr long long iterations = 1000000;
+
+    struct Quote
+    {
+        long long bid;
+        long long ask;
+    };
+
+    lockfree::TripleBuffer<Quote> buffer(Quote{0, 1});
+
+    std::thread writer([&buffer]()
+    {
+        for (long long i = 1; i <= iterations; ++i)
+        {
+            buffer.Write(Quote{i, i + 1});
+        }
+    });
+
+    long long last = 0;
+    while (last < iterations)
+    {
+        if (buffer.Update())
+        {
+            const auto& quote = buffer.Read();
+            ASSERT_EQ(quote.ask, quote.bid + 1);
+            ASSERT_GT(quote.bid, last);
+            last = quote.bid;
+        }
+    }
+
+    writer.join();
+    ASSERT_FALSE(buffer.Update());
+}
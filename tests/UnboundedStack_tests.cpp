@@ -59,6 +59,12 @@ TEST(UnboundedStack_Stress, ConcurrentPushAndPopReturnsAllElements) {
                 ++popped;
             }
         }
+
+        // The producer may have finished after our last Pop.
+        while (stack.Pop())
+        {
+            ++popped;
+        }
     });
 
     producer.join();
@@ -66,4 +72,60 @@ TEST(UnboundedStack_Stress, ConcurrentPushAndPopReturnsAllElements) {
     consumer.join();
 
     ASSERT_EQ(popped, iterations);
-}
\ No newline at end of file
+}
+
+TEST(UnboundedStack_Unit, PopKeepsLifoOrderTest) {
+    lockfree::UnboundedStack<int> stack;
+    for (int i = 0; i < 3; ++i)
+    {
+        stack.Push(i);
+    }
+
+    ASSERT_EQ(stack.Pop(), 2);
+    ASSERT_EQ(stack.Pop(), 1);
+    ASSERT_EQ(stack.Pop(), 0);
+    ASSERT_EQ(stack.Pop(), std::nullopt);
+}
+
+TEST(UnboundedStack_Stress, ConcurrentPushPopWithBackoffPoliciesTest) {
+    constexpr int iterations = 10000;
+    constexpr int producersAmount = 3;
+
+    // Popped nodes are freed right away, so only one thread pops.
+    auto run = [](auto& stack)
+    {
+        long long sum = 0;
+        {
+            std::vector<std::jthread> producers(producersAmount);
+            for (auto& producer : producers)
+            {
+                producer = std::jthread([&stack]()
+                {
+                    for (int i = 0; i < iterations; ++i)
+                    {
+                        stack.Push(i);
+                    }
+                });
+            }
+
+            for (int i = 0; i < iterations * producersAmount; ++i)
+            {
+                std::optional<int> value;
+                while (!(value = stack.Pop())) {}
+                sum += *value;
+            }
+        }
+
+        ASSERT_EQ(sum, producersAmount * (iterations * (iterations - 1LL) / 2));
+        ASSERT_EQ(stack.Pop(), std::nullopt);
+    };
+
+    lockfree::UnboundedStack<int, backoff::None> none;
+    run(none);
+    lockfree::UnboundedStack<int, backoff::Yield> yield;
+    run(yield);
+    lockfree::UnboundedStack<int, backoff::Exponential<64>> exponential;
+    run(exponential);
+    lockfree::UnboundedStack<int, backoff::Adaptive<>> adaptive;
+    run(adaptive);
+}
@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+
+#include <WaitFreeQueue.h>
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+TEST(WaitFreeQueue_Unit, PopEmptyQueueReturnsStdNulloptTest) {
+    lockfree::WaitFreeQueue<int> queue;
+    ASSERT_TRUE(queue.Empty());
+    ASSERT_EQ(queue.Pop(), std::nullopt);
+}
+
+TEST(WaitFreeQueue_Unit, PushPopReturnsSameElementTest) {
+    lockfree::WaitFreeQueue<int> queue;
+    constexpr int value = 5;
+    queue.Push(value);
+    ASSERT_FALSE(queue.Empty());
+    ASSERT_EQ(queue.Pop(), value);
+    ASSERT_EQ(queue.Pop(), std::nullopt);
+}
+
+TEST(WaitFreeQueue_Unit, PopKeepsFifoOrderTest) {
+    lockfree::WaitFreeQueue<int> queue;
+    constexpr int iterations = 100;
+    for (int i = 0; i < iterations; ++i)
+    {
+        queue.Push(i);
+    }
+
+    for (int i = 0; i < iterations; ++i)
+    {
+        ASSERT_EQ(queue.Pop(), i);
+    }
+    ASSERT_EQ(queue.Pop(), std::nullopt);
+}
+
+TEST(WaitFreeQueue_Unit, MoveOnlyElementsAreDestroyedTest) {
+    auto counter = std::make_shared<int>(0);
+    {
+        lockfree::WaitFreeQueue<std::shared_ptr<int>> queue;
+        for (int i = 0; i < 10; ++i)
+        {
+            queue.Push(counter);
+        }
+        ASSERT_EQ(*queue.Pop(), counter);
+    }
+
+    ASSERT_EQ(counter.use_count(), 1);
+}
+
+TEST(WaitFreeQueue_Unit, TooManyThreadsThrowsTest) {
+    lockfree::WaitFreeQueue<int, 1> queue;
+    queue.Push(1);
+    std::jthread([&queue]()
+    {
+        ASSERT_THROW(queue.Push(2), std::length_error);
+    });
+}
+
+TEST(WaitFreeQueue_Stress, ConcurrentPushAndPopReturnsAllElementsTest) {
+    constexpr int iterations = 200000;
+    constexpr int producersAmount = 3;
+    constexpr int consumersAmount = 3;
+
+    lockfree::WaitFreeQueue<int> queue;
+    std::atomic<long long> sum = 0;
+    std::atomic<int> popped = 0;
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producersAmount; ++p)
+    {
+        threads.emplace_back([&queue, p]()
+        {
+            for (int i = 0; i < iterations; ++i)
+            {
+                queue.Push(p * iterations + i);
+            }
+        });
+    }
+
+    for (int c = 0; c < consumersAmount; ++c)
+    {
+        threads.emplace_back([&queue, &sum, &popped]()
+        {
+            std::vector<int> last(producersAmount, -1);
+            while (popped.load(std::memory_order_relaxed) < iterations * producersAmount)
+            {
+                if (auto value = queue.Pop())
+                {
+                    const auto producer = *value / iterations;
+                    ASSERT_GT(*value % iterations, last[producer]);
+                    last[producer] = *value % iterations;
+                    sum.fetch_add(*value, std::memory_order_relaxed);
+                    popped.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    const long long total = iterations * producersAmount;
+    ASSERT_EQ(sum, total * (total - 1) / 2);
+    ASSERT_EQ(queue.Pop(), std::nullopt);
+}